@@ -95,7 +95,7 @@ inline void rread_async(const gptr<T> &src, T *dst, const size_t &size)
 template<typename T>
 inline void aread_sync(const gptr<T> &src, T *dst, const size_t &size)
 {
-	T *origin_addr;
+	T *origin_addr = nullptr;
 	MPI_Get_accumulate(origin_addr, 0, MPI_CHAR, dst, size*sizeof(T), MPI_CHAR,
 				src.rank, src.ptr, size*sizeof(T), MPI_CHAR, MPI_NO_OP, BCL::win);
 	MPI_Win_flush(src.rank, BCL::win);
@@ -104,7 +104,7 @@ inline void aread_sync(const gptr<T> &src, T *dst, const size_t &size)
 template<typename T>
 inline void aread_async(const gptr<T> &src, T *dst, const size_t &size)
 {
-	T *origin_addr;
+	T *origin_addr = nullptr;
 	MPI_Get_accumulate(origin_addr, 0, MPI_CHAR, dst, size*sizeof(T), MPI_CHAR,
 				src.rank, src.ptr, size*sizeof(T), MPI_CHAR, MPI_NO_OP, BCL::win);
 }
@@ -141,6 +141,11 @@ inline void compare_and_swap_sync(const gptr<T> &dst, const T *old_val, const T
 	MPI_Win_flush(dst.rank, BCL::win);
 }
 
+inline void flush(const size_t &rank)
+{
+	MPI_Win_flush(rank, BCL::win);
+}
+
 inline void barrier_sync()
 {
 	MPI_Win_flush_all(BCL::win);
@@ -75,12 +75,24 @@ inline void rput_block2(const T &src, const gptr<T> &dst)
 	rwrite_block2(&src, dst, 1);
 }
 
+template<typename T>
+inline void aput_sync(const T *src, const gptr<T> &dst, const size_t &size)
+{
+	awrite_sync(src, dst, size);
+}
+
 template<typename T>
 inline void aput_sync(const T &src, const gptr<T> &dst)
 {
 	awrite_sync(&src, dst, 1);
 }
 
+template<typename T>
+inline void aput_async(const T *src, const gptr<T> &dst, const size_t &size)
+{
+	awrite_async(src, dst, size);
+}
+
 template<typename T>
 inline void aput_async(const T &src, const gptr<T> &dst)
 {
@@ -121,6 +133,12 @@ inline T rget_sync(const gptr<T> &src)
 	return rv;
 }
 
+template<typename T>
+inline void rget_async(const gptr<T> &src, T *dst, const size_t &size)
+{
+	rread_async(src, dst, size);
+}
+
 template<typename T>
 inline T rget_async(const gptr<T> &src)
 {
@@ -129,6 +147,12 @@ inline T rget_async(const gptr<T> &src)
 	return rv;
 }
 
+template<typename T>
+inline void aget_sync(const gptr<T> &src, T *dst, const size_t &size)
+{
+	aread_sync(src, dst, size);
+}
+
 template<typename T>
 inline T aget_sync(const gptr<T> &src)
 {
@@ -137,6 +161,12 @@ inline T aget_sync(const gptr<T> &src)
 	return rv;
 }
 
+template<typename T>
+inline void aget_async(const gptr<T> &src, T *dst, const size_t &size)
+{
+	aread_async(src, dst, size);
+}
+
 template<typename T>
 inline T aget_async(const gptr<T> &src)
 {
@@ -3,3 +3,7 @@
 #include <bclx/core/util/topology.hpp>
 #include <bclx/core/util/timer.hpp>
 #include <bclx/core/util/backoff.hpp>
+#include <bclx/core/util/clock.hpp>
+#include <bclx/core/util/histogram.hpp>
+#include <bclx/core/util/bench.hpp>
+#include <bclx/core/util/victim.hpp>
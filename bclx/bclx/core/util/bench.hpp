@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>	// std::chrono...
+#include <cstdint>	// uint64_t...
+#include <string>	// std::string...
+#include <vector>	// std::vector...
+#include <sstream>	// std::stringstream...
+
+namespace bclx
+{
+
+std::vector<std::string> split(const std::string &list);	// split a comma-separated list of names
+std::vector<uint64_t> split_num(const std::string &list);	// split a comma-separated list of numbers
+uint64_t now();							// read a monotonic clock (ns)
+void think(const uint64_t &ns);					// busy-wait for ns (ns)
+
+} /* namespace bclx */
+
+std::vector<std::string> bclx::split(const std::string &list)
+{
+	std::vector<std::string>	names;
+	std::stringstream		ss(list);
+	std::string			name;
+
+	while (std::getline(ss, name, ','))
+		names.push_back(name);
+	if (names.empty())
+		names.push_back("");
+	return names;
+}
+
+std::vector<uint64_t> bclx::split_num(const std::string &list)
+{
+	std::vector<uint64_t>	nums;
+
+	for (const std::string &name : split(list))
+		if (!name.empty())
+			nums.push_back(std::stoull(name));
+	return nums;
+}
+
+uint64_t bclx::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void bclx::think(const uint64_t &ns)
+{
+	// busy-wait, since sleeping has a jitter far above a few us
+	uint64_t deadline = now() + ns;
+	while (now() < deadline);
+}
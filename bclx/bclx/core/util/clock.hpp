@@ -0,0 +1,128 @@
+#pragma once
+
+#include <ctime>	// clock_gettime...
+#include <cstdint>	// uint64_t...
+
+namespace bclx
+{
+
+class sync_clock
+{
+public:
+	sync_clock();					// collective: synchronize with the master process
+	~sync_clock();
+	uint64_t now() const;				// read the synchronized clock (ns)
+	uint64_t lower() const;				// read a lower bound of the master's clock (ns)
+	uint64_t upper() const;				// read an upper bound of the master's clock (ns)
+	uint64_t skew() const;				// get the max error of the synchronized clocks (ns)
+	void wait_past(const uint64_t &t) const;	// wait until no process can read a lower bound <= t
+	void interval(const uint64_t &delay_us,		// take a timestamp interval at least delay_us (us) wide
+			uint64_t &start,		// that no interval taken later overlaps
+			uint64_t &end) const;
+
+private:
+	const uint32_t	ROUNDS	= 32;	// # ping-pongs used for calibration
+
+	int64_t		offset;		// be the offset from the local clock to the master's
+	uint64_t	err;		// be the max error of all processes
+
+	uint64_t local() const;		// read the local clock (ns)
+};
+
+} /* namespace bclx */
+
+bclx::sync_clock::sync_clock()
+{
+	uint64_t	t0,
+			t1,
+			t_master,
+			rtt,
+			rtt_min = UINT64_MAX,
+			err_local = 0;
+
+	offset = 0;
+
+	// Cristian's algorithm: keep the round with the shortest round trip
+	for (uint64_t i = 1; i < BCL::nprocs(); ++i)
+	{
+		if (BCL::rank() == 0)
+			for (uint32_t j = 0; j < ROUNDS; ++j)
+			{
+				bclx::recv(t0, i);
+				t_master = local();
+				bclx::send(t_master, i);
+			}
+		else if (BCL::rank() == i)
+			for (uint32_t j = 0; j < ROUNDS; ++j)
+			{
+				t0 = local();
+				bclx::send(t0, 0);
+				bclx::recv(t_master, 0);
+				t1 = local();
+
+				rtt = t1 - t0;
+				if (rtt < rtt_min)
+				{
+					rtt_min = rtt;
+					offset = int64_t(t_master) - int64_t(t0 + rtt / 2);
+					err_local = rtt / 2 + 1;
+				}
+			}
+	}
+
+	MPI_Allreduce(&err_local, &err, 1, MPI_UINT64_T, MPI_MAX, BCL::comm);
+}
+
+bclx::sync_clock::~sync_clock() {}
+
+uint64_t bclx::sync_clock::now() const
+{
+	return local() + offset;
+}
+
+uint64_t bclx::sync_clock::lower() const
+{
+	return now() - err;
+}
+
+uint64_t bclx::sync_clock::upper() const
+{
+	return now() + err;
+}
+
+uint64_t bclx::sync_clock::skew() const
+{
+	return err;
+}
+
+void bclx::sync_clock::wait_past(const uint64_t &t) const
+{
+	// another process may read up to 2 * err below the master's clock
+	while (lower() <= t + 2 * err);	// spin
+}
+
+void bclx::sync_clock::interval(const uint64_t &delay_us, uint64_t &start, uint64_t &end) const
+{
+	uint64_t	deadline;
+
+	start = lower();
+
+	// delay (busy-wait)
+	deadline = now() + delay_us * 1000;
+	while (now() < deadline);
+
+	end = upper();
+
+	// no process may start an interval at or below end once this returns. The
+	// wait lasts about 4 * skew(), so an interval costs the delay plus that,
+	// bounded by the clock error rather than by a single local write
+	wait_past(end);
+}
+
+uint64_t bclx::sync_clock::local() const
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>	// std::vector...
+#include <cstdint>	// uint64_t...
+#include <cmath>	// ceil...
+#include <algorithm>	// std::min...
+
+namespace bclx
+{
+
+// a log-linear histogram in the style of HdrHistogram: values below 2^(SUB_BITS + 1)
+// are counted exactly, larger ones in 2^SUB_BITS sub-buckets per power of two,
+// so that every recorded value is kept within a relative error of 2^-SUB_BITS
+class histogram
+{
+public:
+	histogram();
+	~histogram();
+	void record(const uint64_t &value);		// record a value (e.g. a latency in ns)
+	void reset();
+	uint64_t count() const;				// get # recorded values
+	uint64_t min() const;				// get the min recorded value
+	uint64_t max() const;				// get the max recorded value
+	double mean() const;				// get the mean of the recorded values
+	uint64_t percentile(const double &p) const;	// get the highest value equivalent to the p-th percentile
+	histogram reduce(const MPI_Comm &comm,		// collective: aggregate the histograms of a communicator
+			const int &root) const;
+
+private:
+	static const uint32_t	SUB_BITS	= 5;
+	static const uint32_t	SUB_COUNT	= 1 << SUB_BITS;
+	static const uint32_t	NUM_BUCKETS	= 2 * SUB_COUNT + (64 - SUB_BITS - 1) * SUB_COUNT;
+
+	std::vector<uint64_t>	counts;
+	uint64_t		total;
+	uint64_t		sum;
+	uint64_t		lo;
+	uint64_t		hi;
+
+	uint32_t index_of(const uint64_t &value) const;
+	uint64_t highest_of(const uint32_t &index) const;
+};
+
+} /* namespace bclx */
+
+bclx::histogram::histogram()
+	: counts(NUM_BUCKETS, 0), total{0}, sum{0}, lo{UINT64_MAX}, hi{0} {}
+
+bclx::histogram::~histogram() {}
+
+void bclx::histogram::record(const uint64_t &value)
+{
+	++counts[index_of(value)];
+	++total;
+	sum += value;
+	if (value < lo)
+		lo = value;
+	if (value > hi)
+		hi = value;
+}
+
+void bclx::histogram::reset()
+{
+	counts.assign(NUM_BUCKETS, 0);
+	total = sum = hi = 0;
+	lo = UINT64_MAX;
+}
+
+uint64_t bclx::histogram::count() const
+{
+	return total;
+}
+
+uint64_t bclx::histogram::min() const
+{
+	return (total == 0) ? 0 : lo;
+}
+
+uint64_t bclx::histogram::max() const
+{
+	return hi;
+}
+
+double bclx::histogram::mean() const
+{
+	return (total == 0) ? 0 : double(sum) / total;
+}
+
+uint64_t bclx::histogram::percentile(const double &p) const
+{
+	uint64_t	rank,
+			seen = 0;
+
+	if (total == 0)
+		return 0;
+
+	rank = ceil(p / 100 * total);
+	if (rank == 0)
+		rank = 1;
+	for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+	{
+		seen += counts[i];
+		if (seen >= rank)
+			return std::min(highest_of(i), hi);
+	}
+	return hi;
+}
+
+bclx::histogram bclx::histogram::reduce(const MPI_Comm &comm, const int &root) const
+{
+	histogram	res;
+
+	MPI_Reduce(counts.data(), res.counts.data(), NUM_BUCKETS, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&total, &res.total, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&sum, &res.sum, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&lo, &res.lo, 1, MPI_UINT64_T, MPI_MIN, root, comm);
+	MPI_Reduce(&hi, &res.hi, 1, MPI_UINT64_T, MPI_MAX, root, comm);
+
+	return res;
+}
+
+uint32_t bclx::histogram::index_of(const uint64_t &value) const
+{
+	if (value < 2 * SUB_COUNT)
+		return value;
+
+	// keep the SUB_BITS + 1 most significant bits of the value
+	uint32_t shift = (63 - __builtin_clzll(value)) - SUB_BITS;
+	return 2 * SUB_COUNT + (shift - 1) * SUB_COUNT + (value >> shift) - SUB_COUNT;
+}
+
+uint64_t bclx::histogram::highest_of(const uint32_t &index) const
+{
+	if (index < 2 * SUB_COUNT)
+		return index;
+
+	uint32_t shift = (index - 2 * SUB_COUNT) / SUB_COUNT + 1;
+	uint64_t sub = (index - 2 * SUB_COUNT) % SUB_COUNT + SUB_COUNT;
+	return (sub << shift) + ((uint64_t(1) << shift) - 1);
+}
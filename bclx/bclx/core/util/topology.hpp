@@ -18,6 +18,7 @@ public:
 	topology();
 	~topology();
 	void print();
+	static const topology &shared();	// collective on the first call: get a topology built once per process
 };
 
 class sa
@@ -65,6 +66,14 @@ bclx::topology::~topology()
 	delete[] table;
 }
 
+const bclx::topology &bclx::topology::shared()
+{
+	// each topology splits two communicators, so build this one only once
+	static topology	topo;
+
+	return topo;
+}
+
 void bclx::topology::print()
 {
 	for (int i = 0; i < size; ++i)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <random>	// std::mt19937...
+#include <cstdint>	// uint64_t...
+
+namespace bclx
+{
+
+// a random victim selector for work stealing: it picks a unit of the same
+// compute node with probability LOCAL, and a unit of another compute node
+// otherwise, so that most steals stay within shared memory
+class victim
+{
+public:
+	victim(const topology &topo, const double &local = 0.75);
+	~victim();
+	uint64_t next();			// get a victim other than the calling unit
+	uint64_t next_local();			// get a victim of the same compute node
+	uint64_t next_remote();			// get a victim of another compute node
+
+private:
+	const topology				&topo;
+	double					local;	// be the probability to pick a unit of the same node
+	std::mt19937_64				gen;
+	std::uniform_real_distribution<double>	coin;
+
+	bool is_local(const uint64_t &rank) const;
+};
+
+} /* namespace bclx */
+
+bclx::victim::victim(const topology &topo, const double &local)
+	: topo(topo), local{local}, gen(BCL::rank()), coin(0, 1)
+{
+	// fall back to the only kind of victims there is
+	if (topo.size == 1)
+		this->local = 0;
+	else if (uint64_t(topo.size) == BCL::nprocs())
+		this->local = 1;
+}
+
+bclx::victim::~victim() {}
+
+uint64_t bclx::victim::next()
+{
+	if (BCL::nprocs() == 1)
+		return BCL::rank();
+	if (coin(gen) < local)
+		return next_local();
+	return next_remote();
+}
+
+uint64_t bclx::victim::next_local()
+{
+	if (topo.size == 1)
+		return BCL::rank();
+
+	// skip the calling unit
+	std::uniform_int_distribution<int> dist(0, topo.size - 2);
+	int i = dist(gen);
+	if (i >= topo.rank)
+		++i;
+	return topo.table[i];
+}
+
+uint64_t bclx::victim::next_remote()
+{
+	if (uint64_t(topo.size) == BCL::nprocs())
+		return next_local();
+
+	// a unit is of another node with probability (nprocs - size) / nprocs
+	std::uniform_int_distribution<uint64_t> dist(0, BCL::nprocs() - 1);
+	uint64_t rank;
+	do
+		rank = dist(gen);
+	while (is_local(rank));
+	return rank;
+}
+
+bool bclx::victim::is_local(const uint64_t &rank) const
+{
+	for (int i = 0; i < topo.size; ++i)
+		if (uint64_t(topo.table[i]) == rank)
+			return true;
+	return false;
+}
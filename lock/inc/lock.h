@@ -7,4 +7,8 @@
 
 //#include "lock_mcs.h"	// MCS Lock
 
+//#include "lock_cohort.h"	// Cohort Lock (C-TKT-MCS)
+
+//#include "lock_fc.h"	// Flat-Combining Publication Array
+
 #endif /* LOCK_H */
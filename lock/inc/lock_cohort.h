@@ -0,0 +1,156 @@
+#ifndef LOCK_COHORT_H
+#define LOCK_COHORT_H
+
+namespace dds
+{
+
+namespace cohl
+{
+
+using namespace bclx;
+
+struct elem
+{
+	gptr<elem>	next;
+	uint64_t	status;
+};
+
+// a cohort lock (C-TKT-MCS) [Dice et al., PPoPP'12]: the units of a compute node
+// queue up on a node-local MCS lock, and only the head of each node takes the
+// global ticket lock. A releaser with a waiting successor on its node passes
+// both locks to it with one local put, up to MAX_HANDOFFS times in a row, so
+// the global lock only moves between nodes once per cohort
+class lock
+{
+public:
+	lock();
+	~lock();
+	void acquire();
+	void release();
+
+private:
+	const gptr<elem>	NULL_PTR = nullptr;	//is a null constant
+	const uint64_t		WAIT		= 0;	//be waiting for the local lock
+	const uint64_t		LOCAL_GO	= 1;	//be granted the local lock only
+	const uint64_t		COHORT_GO	= 2;	//be granted both locks (plus # handoffs so far)
+	const uint64_t		MAX_HANDOFFS	= 64;	//bound the unfairness to other nodes
+
+	topology		topo;		//contain node information
+	gptr<gptr<elem>>	tail;		//be the tail of the local lock (hosted by the node leader)
+	gptr<uint64_t>		ticket;		//be the next ticket of the global lock (hosted by MASTER_UNIT)
+	gptr<uint64_t>		serving;	//be the ticket holding the global lock (hosted by MASTER_UNIT)
+	gptr<elem>		self;
+	uint64_t		handoffs;	//be # local handoffs since the global lock was taken
+};
+
+} /* namespace cohl */
+
+} /* namespace dds */
+
+dds::cohl::lock::lock()
+{
+	//synchronize
+	barrier_sync();
+
+	self = BCL::alloc<elem>(1);
+	tail = BCL::alloc<gptr<elem>>(1);
+	ticket = BCL::alloc<uint64_t>(1);
+	serving = BCL::alloc<uint64_t>(1);
+	store(NULL_PTR, tail);
+	store(uint64_t(0), ticket);
+	store(uint64_t(0), serving);
+	tail.rank = topo.table[0];
+	ticket.rank = serving.rank = MASTER_UNIT;
+	handoffs = 0;
+
+	//synchronize
+	barrier_sync();
+}
+
+dds::cohl::lock::~lock()
+{
+	//synchronize
+	barrier_sync();
+
+	tail.rank = ticket.rank = serving.rank = BCL::rank();
+	BCL::dealloc<uint64_t>(serving);
+	BCL::dealloc<uint64_t>(ticket);
+	BCL::dealloc<gptr<elem>>(tail);
+	BCL::dealloc<elem>(self);
+}
+
+void dds::cohl::lock::acquire()
+{
+	gptr<elem>		prevAddr;
+	gptr<gptr<elem>>	nextAddr;
+	gptr<uint64_t>		statusAddr;
+	uint64_t		status,
+				myTicket;
+
+	nextAddr = {self.rank, self.ptr};
+	statusAddr = {self.rank, self.ptr + sizeof(gptr<elem>)};
+	store(NULL_PTR, nextAddr);
+	store(WAIT, statusAddr);
+
+	//queue up on the local lock (node-local)
+	prevAddr = fao_sync(tail, self, BCL::replace<uint64_t>{});
+	if (prevAddr != nullptr)	//queue was non-empty
+	{
+		nextAddr = {prevAddr.rank, prevAddr.ptr};
+		aput_sync(self, nextAddr);
+
+		do {
+			status = aget_sync(statusAddr);
+		} while (status == WAIT);	//spin (local)
+
+		//the predecessor has passed the global lock along
+		if (status >= COHORT_GO)
+		{
+			handoffs = status - COHORT_GO;
+			return;
+		}
+	}
+
+	//take the global lock
+	myTicket = fao_sync(ticket, uint64_t(1), BCL::plus<uint64_t>{});
+	while (aget_sync(serving) != myTicket);	//spin
+	handoffs = 0;
+}
+
+void dds::cohl::lock::release()
+{
+	gptr<elem>		result,
+				nextVal;
+	gptr<gptr<elem>>	nextAddr;
+	gptr<uint64_t>		statusAddr;
+
+	nextAddr = {self.rank, self.ptr};
+	nextVal = aget_sync(nextAddr);
+
+	//pass both locks to a waiting unit of the same node
+	if (nextVal != nullptr && handoffs + 1 < MAX_HANDOFFS)
+	{
+		statusAddr = {nextVal.rank, nextVal.ptr + sizeof(gptr<elem>)};
+		aput_sync(COHORT_GO + handoffs + 1, statusAddr);
+		return;
+	}
+
+	//otherwise, release the global lock first
+	fao_sync(serving, uint64_t(1), BCL::plus<uint64_t>{});
+
+	if (nextVal == nullptr)	//no known successor
+	{
+		result = cas_sync(tail, self, NULL_PTR);
+		if (result == self)
+			return;
+
+		do {
+			nextVal = aget_sync(nextAddr);
+		} while (nextVal == nullptr);	//spin
+	}
+
+	statusAddr = {nextVal.rank, nextVal.ptr + sizeof(gptr<elem>)};
+	aput_sync(LOCAL_GO, statusAddr);
+}
+
+#endif /* LOCK_COHORT_H */
@@ -0,0 +1,215 @@
+#ifndef LOCK_FC_H
+#define LOCK_FC_H
+
+#include <vector>			// std::vector...
+#include <bclx/core/util/backoff.hpp>	// backoff::backoff...
+
+namespace dds
+{
+
+namespace fc
+{
+
+using namespace bclx;
+
+/* Datatypes */
+enum scope : uint32_t
+{
+	GLOBAL,	// every unit posts to one array hosted by MASTER_UNIT
+	NODE	// the units of a compute node post to one array hosted by the node leader
+};
+
+template<typename T>
+struct request
+{
+	uint64_t	seq;	// be the sequence number of the request
+	uint32_t	op;	// be the requested operation
+	T		value;	// be the argument of the operation
+};
+
+template<typename T>
+struct response
+{
+	uint64_t	seq;	// be the sequence number of the served request
+	bool		status;	// be the result of the operation
+	T		value;	// be the result value of the operation
+};
+
+// a publication array of flat combining [Hendler et al., SPAA'10]: every unit
+// posts its requests to its own slot of an array, and whichever unit takes the
+// lock of the array serves all the pending requests in one batch and puts their
+// responses. A request is posted in two steps, its op and value first, then its
+// new sequence number, so that a request found pending is never read torn
+template<typename T>
+class publication
+{
+public:
+	publication(const uint32_t &sc = GLOBAL);	// collective
+	~publication();					// collective
+	uint64_t size() const;				// get # units posting to the array
+	uint64_t publish(const uint32_t &op,		// post a request and get its sequence number
+			const T &value);
+	void requests(std::vector<request<T>> &req);	// get the posted requests of all units
+	template<typename F>
+	response<T> apply(const uint32_t &op,		// post a request and wait for its response, serving
+			const T &value,			// the pending requests by combine(req, resp, pending)
+			const uint32_t &patience,	// after # polls (0: at once) whenever the lock is free
+			F combine);
+
+private:
+	const uint64_t		UNLOCKED	= 0;
+	const uint64_t		LOCKED		= 1;
+
+	gptr<request<T>>	reqs;	// be the publication array
+	gptr<response<T>>	resps;	// be the response array
+	gptr<uint64_t>		lock;	// be the combiner lock
+	uint64_t		num;	// be # units posting to the array
+	uint64_t		index;	// be the slot of the calling unit
+	uint64_t		seq;	// be the sequence number of the last request of the calling unit
+
+	template<typename F>
+	void serve(F combine);
+};
+
+} /* namespace fc */
+
+} /* namespace dds */
+
+template<typename T>
+dds::fc::publication<T>::publication(const uint32_t &sc)
+{
+	topology	topo;
+	uint64_t	host,
+			slots;
+
+	// synchronize
+	bclx::barrier_sync();
+
+	if (sc == NODE)
+	{
+		host = topo.table[0];
+		num = topo.size;
+		index = topo.rank;
+	}
+	else // if (sc == GLOBAL)
+	{
+		host = MASTER_UNIT;
+		num = BCL::nprocs();
+		index = BCL::rank();
+	}
+
+	// every unit allocates as many slots as the largest array has units, so
+	// that the arrays of every host are found at the same offsets
+	MPI_Allreduce(&num, &slots, 1, MPI_UINT64_T, MPI_MAX, BCL::comm);
+	reqs = BCL::alloc<request<T>>(slots);
+	resps = BCL::alloc<response<T>>(slots);
+	lock = BCL::alloc<uint64_t>(1);
+	if (reqs == nullptr || resps == nullptr)
+		printf("[%lu]ERROR: publication.publication\n", BCL::rank());
+	if (BCL::rank() == host)
+	{
+		request<T>	*req = reqs.local();
+		response<T>	*resp = resps.local();
+
+		for (uint64_t i = 0; i < slots; ++i)
+		{
+			req[i].seq = resp[i].seq = 0;
+			req[i].op = 0;
+		}
+		bclx::store(UNLOCKED, lock);
+	}
+	else // if (BCL::rank() != host)
+		reqs.rank = resps.rank = lock.rank = host;
+	seq = 0;
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+dds::fc::publication<T>::~publication()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	reqs.rank = resps.rank = lock.rank = BCL::rank();
+	BCL::dealloc<uint64_t>(lock);
+	BCL::dealloc<response<T>>(resps);
+	BCL::dealloc<request<T>>(reqs);
+}
+
+template<typename T>
+uint64_t dds::fc::publication<T>::size() const
+{
+	return num;
+}
+
+template<typename T>
+uint64_t dds::fc::publication<T>::publish(const uint32_t &op, const T &value)
+{
+	gptr<request<T>>	req = reqs + index;
+
+	bclx::rput_sync(request<T>{seq, op, value}, req);		// one RMA
+	bclx::aput_sync(++seq, gptr<uint64_t>{req.rank, req.ptr});	// one RMA
+	return seq;
+}
+
+template<typename T>
+void dds::fc::publication<T>::requests(std::vector<request<T>> &req)
+{
+	req.resize(num);
+	bclx::aget_sync(reqs, req.data(), num);	// one RMA
+}
+
+template<typename T>
+template<typename F>
+dds::fc::response<T> dds::fc::publication<T>::apply(const uint32_t &op, const T &value, const uint32_t &patience, F combine)
+{
+	response<T>	resp;
+	uint32_t	polls = 0;
+	backoff		bk(bk_init, bk_max);
+
+	publish(op, value);
+	while (true)
+	{
+		// check if a combiner has served the request
+		resp = bclx::rget_sync(resps + index);	// one RMA
+		if (resp.seq == seq)
+			return resp;
+
+		// become the combiner once patient enough
+		if (++polls > patience && bclx::cas_sync(lock, UNLOCKED, LOCKED) == UNLOCKED)	// one RMA
+		{
+			serve(combine);
+			bclx::aput_sync(UNLOCKED, lock);	// one RMA
+			polls = 0;
+		}
+		else
+			bk.delay_inc();
+	}
+}
+
+template<typename T>
+template<typename F>
+void dds::fc::publication<T>::serve(F combine)
+{
+	std::vector<request<T>>		req;
+	std::vector<response<T>>	resp(num);
+	std::vector<uint64_t>		pending;
+
+	// collect the pending requests
+	requests(req);					// one RMA
+	bclx::rget_sync(resps, resp.data(), num);	// one RMA
+	for (uint64_t i = 0; i < num; ++i)
+		if (req[i].seq != resp[i].seq)
+			pending.push_back(i);
+	if (pending.empty())
+		return;
+
+	combine(req, resp, pending);
+
+	// hand out the responses
+	bclx::rput_sync(resp.data(), resps, num);	// one RMA
+}
+
+#endif /* LOCK_FC_H */
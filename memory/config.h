@@ -11,10 +11,13 @@ namespace dds
 	/* Macros */
 	//#define		DEBUGGING
 	#define		MEM_DANG6
+	//#define		MEM_HELP
+	//#define		ELEM_PADDED	// start every elem of a memory pool on its own cache line
 
         /* Constants */
 	const uint64_t	MASTER_UNIT	= 0;
 	const uint64_t	TOTAL_OPS	= exp2l(23);
+	const uint64_t	WM_FREE_LOW	= exp2l(6);	// low watermark of free elems
 
 	/* Varriables */
 	std::string	mem_manager;
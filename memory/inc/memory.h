@@ -3,6 +3,10 @@
 
 #include "../config.h"		// Configurations
 
+#include "memory_stats.h"	// Reclamation Statistics
+
+#include "memory_layout.h"	// Layout of Elems in Memory Pools
+
 //#include "memory_lb.h"		// Using It with Lock-Based Data Structures Only
 
 #include "memory_nmr.h"		// Using No Memory Reclamation
@@ -15,9 +19,11 @@
 
 //#include "memory_ebr3.h"	// Using Epoch-Based Reclamation [Herlihy et al., Book'20]
 
-//#include "memory_he.h"		// Using Hazard Eras [Ramalhete & Correia, SPAA'17]
+#include "memory_he.h"		// Using Hazard Eras [Ramalhete & Correia, SPAA'17]
 
-//#include "memory_ibr.h"		// Using Interval-Based Reclamation (2GEIBR) [Wen et al., PPoPP'18]
+#include "memory_ibr.h"		// Using Interval-Based Reclamation (2GEIBR) [Wen et al., PPoPP'18]
+
+#include "memory_nbr.h"		// Using Neutralization-Based Reclamation [Singh et al., PPoPP'21]
 
 #include "memory_dang.h"	// Using Hazard Pointers + the TAKEN Field
 
@@ -37,4 +43,31 @@
 
 #include "memory_bl3.h"		// Baseline 3: Using Hazard Pointers + Maximum Locality
 
+namespace dds
+{
+
+/* Traits */
+template<typename M>
+struct mem_traits
+{
+	static const bool	NEUTRALIZING	= false;	// reserved reads must be confirmed by try_reserve before writing
+	static const bool	LOCAL_ALLOC	= false;	// malloc only returns elems of the calling unit
+};
+
+template<typename T>
+struct mem_traits<nbr::memory<T>>
+{
+	static const bool	NEUTRALIZING	= true;
+	static const bool	LOCAL_ALLOC	= false;
+};
+
+template<typename T>
+struct mem_traits<dang3::memory<T>>
+{
+	static const bool	NEUTRALIZING	= false;
+	static const bool	LOCAL_ALLOC	= true;
+};
+
+} /* namespace dds */
+
 #endif /* MEMORY_H */
@@ -60,8 +60,8 @@ dds::bl::memory<T>::memory()
 		++temp;
 	}
 
-	pool = pool_rep = BCL::alloc<T>(TOTAL_OPS);
-        capacity = pool.ptr + TOTAL_OPS * sizeof(T);
+	pool = pool_rep = pool_alloc<T>(TOTAL_OPS);
+        capacity = pool.ptr + TOTAL_OPS * layout<T>::STRIDE;
 }
 
 template<typename T>
@@ -87,7 +87,11 @@ bclx::gptr<T> dds::bl::memory<T>::malloc()
                 return addr;
 	}
         else if (pool.ptr < capacity)	// the list of reclaimed global memory is empty
-		return pool++;
+	{
+		gptr<T> addr = pool;
+		pool.ptr += layout<T>::STRIDE;
+		return addr;
+	}
 	else
 		return nullptr;
 }
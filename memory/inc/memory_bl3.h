@@ -19,7 +19,7 @@ using namespace bclx;
 template<typename T>
 struct list_seq2
 {
-	sds::list<T>		contig;
+	pool_list<T>		contig;
 	std::vector<gptr<T>>	ncontig;
 };
 
@@ -45,10 +45,13 @@ private:
         const uint64_t		HP_TOTAL	= BCL::nprocs() * HPS_PER_UNIT;
         const uint64_t		HP_WINDOW	= HP_TOTAL * 2;
 
-	sds::list<T>         	pool_mem;	// allocate global memory
+	pool_list<T>         	pool_mem;	// allocate global memory
 	gptr<T>         	pool_rep;	// deallocate global memory
 	gptr<gptr<T>>		reservation;	// be an array of hazard pointers of the calling unit
 	std::vector<gptr<T>>	list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>	list_ts;	// contain retire times of elems in list_ret
+	#endif
 	list_seq2<T>		lheap;		// be per-unit heap
 
 	void empty();
@@ -71,7 +74,7 @@ dds::bl3::memory<T>::memory()
 		++temp;
 	}
 
-	pool_rep = BCL::alloc<T>(TOTAL_OPS);
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
 	if (pool_rep == nullptr)
 	{
 		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
@@ -99,8 +102,7 @@ bclx::gptr<T> dds::bl3::memory<T>::malloc()
 	// otherwise, get elems from the memory pool
 	if (!pool_mem.empty())
 	{
-		gptr<T> ptr = pool_mem.pop(HP_WINDOW);
-		lheap.contig.set(ptr, HP_WINDOW);
+		lheap.contig = pool_mem.pop(HP_WINDOW);
 
 		return lheap.contig.pop();
 	}
@@ -120,6 +122,12 @@ template<typename T>
 void dds::bl3::memory<T>::retire(const gptr<T>& ptr)
 {
 	list_ret.push_back(ptr);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
 	if (list_ret.size() >= HP_WINDOW)
 		empty();
 }
@@ -218,6 +226,13 @@ void dds::bl3::memory<T>::empty()
 	gptr<gptr<T>> 		hp_temp;	// a temporary variable
 	gptr<T>			ptr;		// a temporary variable
 
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
 	plist.reserve(HP_TOTAL);
 	new_dlist.reserve(HP_TOTAL);
 
@@ -244,13 +259,28 @@ void dds::bl3::memory<T>::empty()
 	{
 		ptr = list_ret.back();
 		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
 		if (std::binary_search(plist.begin(), plist.end(), ptr))
+		{
 			new_dlist.push_back(ptr);
+
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
 		else
 		{
 			// tracing
 			#ifdef	TRACING
 				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
 			#endif
 
 			free(ptr);
@@ -259,6 +289,14 @@ void dds::bl3::memory<T>::empty()
 
 	// Stage 4
 	list_ret = std::move(new_dlist);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
 }
 
 #endif /* MEMORY_BL3_H */
@@ -71,8 +71,8 @@ dds::dang::memory<T>::memory()
 		++temp;
 	}
 
-        pool = pool_rep = BCL::alloc<block<T>>(TOTAL_OPS);
-        capacity = pool.ptr + TOTAL_OPS * sizeof(block<T>);
+        pool = pool_rep = pool_alloc<block<T>>(TOTAL_OPS);
+        capacity = pool.ptr + TOTAL_OPS * layout<block<T>>::STRIDE;
 
 	counter = 0;
 	list_ret.reserve(HP_WINDOW);
@@ -126,7 +126,7 @@ bclx::gptr<T> dds::dang::memory<T>::malloc()
 			bclx::store(true, temp);
 			gptr<T> addr = {pool.rank, pool.ptr + sizeof(pool.rank)};
 			list_all.push_back(addr);
-			pool++;
+			pool.ptr += layout<block<T>>::STRIDE;
 			return addr;
 		}
                 else // if (pool.ptr == capacity)
@@ -20,7 +20,7 @@ using namespace bclx;
 template<typename T>
 struct list_seq2
 {
-	sds::list<T>		contig;
+	pool_list<T>		contig;
 	std::vector<gptr<T>>	ncontig;
 };
 
@@ -46,7 +46,7 @@ private:
         const uint64_t		HP_TOTAL	= BCL::nprocs() * HPS_PER_UNIT;
         const uint64_t		HP_WINDOW	= HP_TOTAL * 2;
 
-	sds::list<T>						pool_mem;	// allocate global memory
+	pool_list<T>						pool_mem;	// allocate global memory
 	gptr<T>         					pool_rep;	// deallocate global memory
 	gptr<gptr<T>>						reservation;	// be a reservation array of the calling unit
 	std::vector<gptr<T>>					list_ret;	// contain retired elems
@@ -74,7 +74,7 @@ dds::dang2::memory<T>::memory()
 		++temp;
 	}
 
-	pool_rep = BCL::alloc<T>(TOTAL_OPS);
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
 	if (pool_rep == nullptr)
 	{
 		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
@@ -192,8 +192,7 @@ bclx::gptr<T> dds::dang2::memory<T>::malloc()
 			++cnt_pool;
 		#endif
 
-		gptr<T> ptr = pool_mem.pop(HP_WINDOW);
-        	lheap.contig.set(ptr, HP_WINDOW);
+		lheap.contig = pool_mem.pop(HP_WINDOW);
 
                 return lheap.contig.pop();
 	}
@@ -20,7 +20,7 @@ using namespace bclx;
 template<typename T>
 struct list_seq2
 {
-	sds::list<T>		contig;
+	pool_list<T>		contig;
 	std::vector<gptr<T>>	ncontig;
 };
 
@@ -46,14 +46,24 @@ private:
         const uint64_t		HP_TOTAL	= BCL::nprocs() * HPS_PER_UNIT;
         const uint64_t		HP_WINDOW	= HP_TOTAL * 2;
 
-	sds::list<T>						pool_mem;	// allocate global memory
+	pool_list<T>						pool_mem;	// allocate global memory
 	gptr<T>         					pool_rep;	// deallocate global memory
 	gptr<gptr<T>>						reservation;	// be a reservation array of the calling unit
 	std::vector<gptr<T>>					list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>					list_ts;	// contain retire times of elems in list_ret
+	#endif
 	list_seq2<T>						lheap;		// be per-unit heap
 	std::vector<std::vector<gptr<T>>>			buffers;	// be local buffers
 	std::vector<std::vector<dds::queue_spsc<gptr<T>>>>	queues;		// be SPSC queues
-
+	std::vector<bool>					unflushed;	// be set for the owners whose last batch is not completed
+	gptr<uint64_t>						help;		// be set when another unit runs out of memory
+	bool							help_asked;	// be set when the calling unit has asked for help
+
+	uint64_t num_free() const;
+	void give_back(const uint64_t &rank);
+	void ask_help();
+	void help_reclaim();
         void empty();
 };
 
@@ -74,7 +84,7 @@ dds::dang3::memory<T>::memory()
 		++temp;
 	}
 
-	pool_rep = BCL::alloc<T>(TOTAL_OPS);
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
 	if (pool_rep == nullptr)
 	{
 		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
@@ -96,6 +106,13 @@ dds::dang3::memory<T>::memory()
 		buffers.push_back(std::vector<gptr<T>>());
 		buffers[i].reserve(HP_WINDOW);
 	}
+	unflushed.resize(BCL::nprocs(), false);
+
+	#ifdef	MEM_HELP
+		help = BCL::alloc<uint64_t>(1);
+		bclx::store(uint64_t(0), help);
+	#endif
+	help_asked = false;
 }
 
 template<typename T>
@@ -105,6 +122,9 @@ dds::dang3::memory<T>::~memory()
 		for (uint64_t j = 0; j < BCL::nprocs(); ++j)
 			queues[i][j].clear();
 
+	#ifdef	MEM_HELP
+		BCL::dealloc<uint64_t>(help);
+	#endif
         BCL::dealloc<T>(pool_rep);
 	BCL::dealloc<gptr<T>>(reservation);
 }
@@ -118,6 +138,7 @@ bclx::gptr<T> dds::dang3::memory<T>::malloc()
 		// tracing
 		#ifdef	TRACING
 			++elem_ru;
+			++mstats.reused;
 		#endif
 
 		gptr<T> ptr = lheap.ncontig.back();
@@ -127,15 +148,13 @@ bclx::gptr<T> dds::dang3::memory<T>::malloc()
 
 	// if lheap.contig is not empty, return a gptr<T> from it
 	if (!lheap.contig.empty())
+	{
 		return lheap.contig.pop();
+	}
 
 	// otherwise, scan all queues to get reclaimed elems if any
 	for (uint64_t i = 0; i < queues[BCL::rank()].size(); ++i)
-	{
-		std::vector<gptr<T>> slist;
-		if (queues[BCL::rank()][i].dequeue(slist))
-			lheap.ncontig.insert(lheap.ncontig.end(), slist.begin(), slist.end());
-	}
+		queues[BCL::rank()][i].dequeue(lheap.ncontig);
 	
 	// if lheap.ncontig is not empty, return a gptr<T> from it
 	if (!lheap.ncontig.empty())
@@ -143,8 +162,10 @@ bclx::gptr<T> dds::dang3::memory<T>::malloc()
 		// tracing
 		#ifdef	TRACING
 			++elem_ru;
+			++mstats.reused;
 		#endif
 
+		help_asked = false;
 		gptr<T> ptr = lheap.ncontig.back();
 		lheap.ncontig.pop_back();
 		return ptr;
@@ -153,19 +174,14 @@ bclx::gptr<T> dds::dang3::memory<T>::malloc()
 	// otherwise, get elems from the memory pool
 	if (!pool_mem.empty())
 	{
-		gptr<T> ptr = pool_mem.pop(HP_WINDOW);
-        	lheap.contig.set(ptr, HP_WINDOW);
+		lheap.contig = pool_mem.pop(HP_WINDOW);
 
                 return lheap.contig.pop();
 	}
 
 	// try to scan all queues to get relaimed elems one more
 	for (uint64_t i = 0; i < queues[BCL::rank()].size(); ++i)
-	{
-		std::vector<gptr<T>> slist;
-		if (queues[BCL::rank()][i].dequeue(slist))
-			lheap.ncontig.insert(lheap.ncontig.end(), slist.begin(), slist.end());
-        }
+		queues[BCL::rank()][i].dequeue(lheap.ncontig);
 
         // if lheap.ncontig is not empty, return a gptr<T> from it
         if (!lheap.ncontig.empty())
@@ -173,15 +189,22 @@ bclx::gptr<T> dds::dang3::memory<T>::malloc()
 		// tracing
 		#ifdef	TRACING
 			++elem_ru;
+			++mstats.reused;
 		#endif
 
+		help_asked = false;
 		gptr<T> ptr = lheap.ncontig.back();
 		lheap.ncontig.pop_back();
                 return ptr;
         }
+
+	// ask the other units to return elems of the calling unit they hold
+	#ifdef	MEM_HELP
+		if (!help_asked)
+			ask_help();
+	#endif
 	
-	// otherwise, return nullptr
-	printf("[%lu]ERROR: memory.malloc\n", BCL::rank());
+	// otherwise, return nullptr to push back on the caller
 	return nullptr;
 }
 
@@ -194,10 +217,7 @@ void dds::dang3::memory<T>::free(const gptr<T>& ptr)
 	{
 		buffers[ptr.rank].push_back(ptr);
 		if (buffers[ptr.rank].size() >= HP_WINDOW)
-		{
-			queues[ptr.rank][BCL::rank()].enqueue(buffers[ptr.rank]);
-			buffers[ptr.rank].clear();
-		}
+			give_back(ptr.rank);
 	}
 }
 
@@ -205,7 +225,24 @@ template<typename T>
 void dds::dang3::memory<T>::retire(const gptr<T>& ptr)
 {
 	list_ret.push_back(ptr);
-	if (list_ret.size() >= HP_WINDOW)
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
+
+	// help the units that have run out of memory
+	#ifdef	MEM_HELP
+		if (bclx::aget_sync(help) != 0)	// local
+		{
+			help_reclaim();
+			return;
+		}
+	#endif
+
+	// scan eagerly while free elems are below the low watermark
+	if (list_ret.size() >= HP_WINDOW || num_free() < WM_FREE_LOW)
 		empty();
 }
 
@@ -295,6 +332,60 @@ void dds::dang3::memory<T>::unreserve(const gptr<T>& ptr)
 	}
 }
 
+template<typename T>
+uint64_t dds::dang3::memory<T>::num_free() const
+{
+	return pool_mem.size() + lheap.contig.size() + lheap.ncontig.size();
+}
+
+template<typename T>
+void dds::dang3::memory<T>::give_back(const uint64_t &rank)
+{
+	// enqueue as much of the buffer as the ring of the owner has room for, so
+	// that a buffer grown past the capacity of the ring still drains; the
+	// rest is retried once the owner has made room
+	std::vector<gptr<T>>	&buf = buffers[rank];
+	uint64_t		num = std::min(uint64_t(buf.size()), queues[rank][BCL::rank()].room(buf.size()));
+
+	if (num == 0 || !queues[rank][BCL::rank()].enqueue(buf.data() + (buf.size() - num), num))
+		return;
+	buf.resize(buf.size() - num);
+	unflushed[rank] = true;
+}
+
+template<typename T>
+void dds::dang3::memory<T>::ask_help()
+{
+	gptr<uint64_t> temp = help;
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (i != BCL::rank())
+		{
+			temp.rank = i;
+			bclx::aput_sync(uint64_t(1), temp);	// one RMA
+		}
+	help_asked = true;
+}
+
+template<typename T>
+void dds::dang3::memory<T>::help_reclaim()
+{
+	bclx::aput_sync(uint64_t(0), help);	// local
+
+	// reclaim as many retired elems as possible
+	empty();
+
+	// return partially filled buffers to their owners right away
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (i != BCL::rank() && !buffers[i].empty())
+			give_back(i);
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (unflushed[i])
+		{
+			queues[i][BCL::rank()].flush();
+			unflushed[i] = false;
+		}
+}
+
 template<typename T>
 void dds::dang3::memory<T>::empty()
 {	
@@ -303,6 +394,13 @@ void dds::dang3::memory<T>::empty()
 	gptr<gptr<T>> 		hp_temp;	// a temporary variable
 	gptr<T>			ptr;		// a temporary variable
 
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
 	plist.reserve(HP_TOTAL);
 	new_dlist.reserve(HP_TOTAL);
 
@@ -329,13 +427,28 @@ void dds::dang3::memory<T>::empty()
 	{
 		ptr = list_ret.back();
 		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
 		if (std::binary_search(plist.begin(), plist.end(), ptr))
+		{
 			new_dlist.push_back(ptr);
+
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
 		else
 		{
 			// tracing
 			#ifdef	TRACING
 				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
 			#endif
 
 			free(ptr);
@@ -344,6 +457,22 @@ void dds::dang3::memory<T>::empty()
 
 	// Stage 4
 	list_ret = std::move(new_dlist);
+
+	// complete the tails of the batches returned to their owners
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (unflushed[i])
+		{
+			queues[i][BCL::rank()].flush();
+			unflushed[i] = false;
+		}
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
 }
 
 #endif /* MEMORY_DANG3_H */
@@ -191,10 +191,9 @@ bclx::gptr<T> dds::dang4::memory<T>::malloc()
 			++cnt_pool;
 		#endif
 
-		gptr<block<T>> ptr = pool_mem.pop(HP_WINDOW);
-        	lheap.contig.set(ptr, HP_WINDOW);
+		lheap.contig = pool_mem.pop(HP_WINDOW);
 
-                ptr = lheap.contig.pop();
+                gptr<block<T>> ptr = lheap.contig.pop();
                 return {ptr.rank, ptr.ptr + sizeof(header)};
 	}
 
@@ -1,10 +1,11 @@
 #ifndef MEMORY_HE_H
 #define MEMORY_HE_H
 
-#include <cstdint>	// uint64_t...
-#include <vector>	// std::vector...
-#include <limits>	// std::numeric_limits...
-#include <utility>	// std::pair...
+#include <cstdint>		// uint64_t...
+#include <cstddef>		// offsetof...
+#include <vector>		// std::vector...
+#include <algorithm>		// std::sort...
+#include <utility>		// std::move...
 
 namespace dds
 {
@@ -12,10 +13,14 @@ namespace dds
 namespace he
 {
 
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
 template<typename T>
 struct block
 {
-	uint64_t	era_new;
+	uint64_t	era_new;	// be the birth era of elem
 	T		elem;
 };
 
@@ -35,27 +40,40 @@ public:
 	~memory();
 	gptr<T> malloc();			// allocate global memory
 	void free(const gptr<T>&);		// deallocate global memory
+	void retire(const gptr<T>&);		// retire a global pointer
 	void op_begin();			// indicate the beginning of a concurrent operation
 	void op_end();				// indicate the end of a concurrent operation
-	gptr<T> reserve(const gptr<gptr<T>>&);	// try to protect a global pointer from reclamation
+	bool try_reserve(const gptr<gptr<T>>&,	// try to protect a global pointer from reclamation
+			const gptr<T>&);
+	gptr<T> reserve(const gptr<gptr<T>>&);	// protect a global pointer from reclamation
 	void unreserve(const gptr<T>&);		// stop protecting a global pointer
 
 private:
-	const uint64_t		MIN		= std::numeric_limits<uint64_t>::min();
-	const uint32_t		HPS_PER_UNIT	= 1;
+	const gptr<T>		NULL_PTR 	= nullptr;
+	const uint64_t		NULL_ERA	= 0;
+	const uint64_t		OFFSET		= offsetof(block<T>, elem);
+        const uint32_t		HES_PER_UNIT 	= 1;
+        const uint64_t		HE_TOTAL	= BCL::nprocs() * HES_PER_UNIT;
 	const uint64_t		EPOCH_FREQ	= BCL::nprocs();	// freq. of increasing epoch
-	const uint64_t		EMPTY_FREQ	= BCL::nprocs() * 2;	// freq. of reclaiming retired
-
-	gptr<block<T>>					pool;		// allocate PGAS
-	gptr<block<T>>					pool_rep;	// deallocate PGAS
-	uint64_t					capacity;	// contain gmem capacity (bytes)
-	gptr<uint64_t>					epoch;		// a global clock
-	gptr<uint64_t>					reservation;	// contain the reserved things
-	std::vector<std::pair<gptr<T>, uint32_t>>	dictionary;	// contain (ptr, index)s
-	uint64_t					counter;	// a local counter
-	std::vector<sblock<T>>				list_ret;	// contain retired elems
-	std::vector<gptr<block<T>>>			list_rec;	// contain reclaimed elems
-
+	const uint64_t		EMPTY_FREQ	= HE_TOTAL * 2;		// freq. of reclaiming retired
+
+	pool_list<block<T>>		pool_mem;	// allocate global memory
+	gptr<block<T>>			pool_rep;	// deallocate global memory
+	gptr<uint64_t>			epoch;		// be a global clock
+	uint64_t			era_local;	// be the cached value of epoch
+	gptr<uint64_t>			reservation;	// be an array of hazard eras of the calling unit
+	std::vector<gptr<T>>		reserved;	// contain the elems protected by reservation
+	gptr<T>				last_ptr;	// be the last reserved elem
+	uint64_t			last_era;	// be the birth era of last_ptr
+	uint64_t			counter;	// be # allocations of the calling unit
+	std::vector<sblock<T>>		list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>		list_ts;	// contain retire times of elems in list_ret
+	#endif
+	std::vector<gptr<block<T>>>	list_rec;	// contain reclaimed elems
+
+	gptr<block<T>> to_block(const gptr<T>&) const;
+	uint64_t birth(const gptr<T>&);
 	void empty();
 };
 
@@ -70,21 +88,29 @@ dds::he::memory<T>::memory()
 	if (BCL::rank() == MASTER_UNIT)
 	{
 		mem_manager = "HE";
-		BCL::store(uint64_t(1), epoch);
+		bclx::store(uint64_t(1), epoch);
 	}
 	else // if (BCL::rank() != MASTER_UNIT)
 		epoch.rank = MASTER_UNIT;
+	era_local = 1;
 
-	gptr<uint64_t> temp = reservation = BCL::alloc<uint64_t>(HPS_PER_UNIT);
-	for (uint32_t i = 0; i < HPS_PER_UNIT; ++i)
+	gptr<uint64_t> temp = reservation = BCL::alloc<uint64_t>(HES_PER_UNIT);
+	for (uint32_t i = 0; i < HES_PER_UNIT; ++i)
 	{
-		BCL::store(MIN, temp);
+		bclx::store(NULL_ERA, temp);
 		++temp;
 	}
-	dictionary.reserve(HPS_PER_UNIT);
+	reserved.resize(HES_PER_UNIT, NULL_PTR);
+	last_ptr = NULL_PTR;
+	last_era = NULL_ERA;
 
-	pool = pool_rep = BCL::alloc<block<T>>(TOTAL_OPS);
-	capacity = pool.ptr + TOTAL_OPS * sizeof(block<T>);
+	pool_rep = pool_alloc<block<T>>(TOTAL_OPS);
+        if (pool_rep == nullptr)
+	{
+		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
+		return;
+	}
+	pool_mem.set(pool_rep, TOTAL_OPS);
 
 	counter = 0;
 	list_ret.reserve(EMPTY_FREQ);
@@ -100,188 +126,274 @@ dds::he::memory<T>::~memory()
 }
 
 template<typename T>
-dds::gptr<T> dds::he::memory<T>::malloc()
+bclx::gptr<T> dds::he::memory<T>::malloc()
 {
-	// determine the global address of the new element
+	gptr<block<T>> addr;
+
+	// advance the global clock periodically, refreshing the cached era
+	++counter;
+	if (counter % EPOCH_FREQ == 0)
+		era_local = bclx::fao_sync(epoch, uint64_t(1), BCL::plus<uint64_t>{}) + 1;	// one RMA
+
+	// if list_rec is not empty, return a gptr<T> from it
 	if (!list_rec.empty())
 	{
 		// tracing
 		#ifdef  TRACING
-			elem_ru++;
+			++elem_ru;
+			++mstats.reused;
 		#endif
 
-		gptr<block<T>> addr = list_rec.back();
+		addr = list_rec.back();
 		list_rec.pop_back();
-		gptr<uint64_t> temp = {addr.rank, addr.ptr};
-		uint64_t timestamp = aget_sync(epoch);	// one RMA
-		BCL::rput_sync(timestamp, temp);	// one RMA
-		return {addr.rank, addr.ptr + sizeof(uint64_t)};
 	}
-	else // the list of reclaimed global empty is empty
+
+	// otherwise, get an elem from the memory pool
+	else if (!pool_mem.empty())
+		addr = pool_mem.pop();
+
+	// otherwise, try to reclaim global memory one more
+	else
 	{
-		if (pool.ptr < capacity)
-		{
-			gptr<T> addr = {pool.rank, pool.ptr + sizeof(uint64_t)};
-			gptr<uint64_t> temp = {pool.rank, pool.ptr};
-			uint64_t timestamp = aget_sync(epoch);	// one RMA
-			BCL::store(timestamp, temp);
-			++pool;
-			return addr;
-		}
-		else // if (pool.ptr == capacity)
-		{
-			empty();
-			if (!list_rec.empty())
-			{
-				// tracing
-				#ifdef  TRACING
-					elem_ru++;
-				#endif
-
-				gptr<block<T>> addr = list_rec.back();
-				list_rec.pop_back();
-				gptr<uint64_t> temp = {addr.rank, addr.ptr};
-				uint64_t timestamp = aget_sync(epoch);	// one RMA
-				BCL::rput_sync(timestamp, temp);	// one RMA
-				return {addr.rank, addr.ptr + sizeof(uint64_t)};
-			}
-		}
+		empty();
+		if (list_rec.empty())
+			return nullptr;
+
+		// tracing
+		#ifdef  TRACING
+			++elem_ru;
+			++mstats.reused;
+		#endif
+
+		addr = list_rec.back();
+		list_rec.pop_back();
 	}
-	return nullptr;
+
+	// stamp the birth era of the new elem with the cached era
+	gptr<uint64_t> temp = {addr.rank, addr.ptr};
+	if (addr.rank == BCL::rank())
+		bclx::store(era_local, temp);
+	else // if (addr.rank != BCL::rank())
+		bclx::rput_sync(era_local, temp);	// one RMA
+	return {addr.rank, addr.ptr + OFFSET};
 }
 
 template<typename T>
 void dds::he::memory<T>::free(const gptr<T>& ptr)
 {
-	uint64_t era_del = BCL::aget_sync(epoch);	// one RMA
-	gptr<block<T>> temp = {ptr.rank, ptr.ptr - sizeof(uint64_t)};
-	gptr<uint64_t> temp2 = {temp.rank, temp.ptr};
-	uint64_t era_new = BCL::rget_sync(temp2);	// one RMA
-	list_ret.push_back({era_new, era_del, temp});
+	list_rec.push_back(to_block(ptr));
+}
 
-	++counter;
-	if (counter % EPOCH_FREQ == 0)
-		BCL::cas_sync(epoch, era_del, era_del + 1);	// one RMA
+template<typename T>
+void dds::he::memory<T>::retire(const gptr<T>& ptr)
+{
+	uint64_t era_new = (ptr == last_ptr) ? last_era : birth(ptr);
+	era_local = bclx::aget_sync(epoch);	// one RMA
+	list_ret.push_back({era_new, era_local, to_block(ptr)});
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
 
-	if (list_ret.size() % EMPTY_FREQ == 0)
+	if (list_ret.size() >= EMPTY_FREQ)
 		empty();
 }
 
 template<typename T>
-void dds::he::memory<T>::op_begin()
-{
-	/* No-op */
-}
+void dds::he::memory<T>::op_begin() {}
+
+template<typename T>
+void dds::he::memory<T>::op_end() {}
 
 template<typename T>
-void dds::he::memory<T>::op_end()
+bool dds::he::memory<T>::try_reserve(const gptr<gptr<T>>& ptr, const gptr<T>& val_old)
 {
-	/* No-op */	
+	if (val_old == NULL_PTR)
+		return false;
+	else // if (val_old != NULL_PTR)
+	{
+		gptr<uint64_t> temp = reservation;
+		for (uint32_t i = 0; i < HES_PER_UNIT; ++i)
+			if (reserved[i] == NULL_PTR)
+			{
+				uint64_t	era = era_local,
+						era_new;
+				bclx::aput_sync(era, temp);	// local
+				while (true)
+				{
+					if (bclx::aget_sync(ptr) != val_old)	// one RMA
+					{
+						bclx::aput_sync(NULL_ERA, temp);	// local
+						return false;
+					}
+					era_new = birth(val_old);
+					if (era_new <= era)
+					{
+						reserved[i] = last_ptr = val_old;
+						last_era = era_new;
+						return true;
+					}
+					era = era_new;
+					bclx::aput_sync(era, temp);	// local
+				}
+			}
+			else // if (reserved[i] != NULL_PTR)
+				++temp;
+		printf("[%lu]ERROR: memory.try_reserve\n", BCL::rank());
+		return false;
+	}
 }
 
 template<typename T>
-dds::gptr<T> dds::he::memory<T>::reserve(const gptr<gptr<T>>& ptr)
+bclx::gptr<T> dds::he::memory<T>::reserve(const gptr<gptr<T>>& ptr)
 {
 	gptr<uint64_t> temp = reservation;
-	for (uint32_t i = 0; i < HPS_PER_UNIT; ++i)
-		if (BCL::aget_sync(temp) == MIN)
+	for (uint32_t i = 0; i < HES_PER_UNIT; ++i)
+		if (reserved[i] == NULL_PTR)
 		{
-			uint64_t	era_old,
+			uint64_t	era = era_local,
 					era_new;
-			gptr<T>		result;
-			era_old = BCL::aget_sync(epoch);	// one RMA
-			BCL::aput_sync(era_old, temp);
+			gptr<T>		val;
+			bclx::aput_sync(era, temp);	// local
 			while (true)
 			{
-				result = BCL::aget_sync(ptr);	// one RMA
-				if (result == nullptr)
+				val = bclx::aget_sync(ptr);	// one RMA
+				if (val == NULL_PTR)
+				{
+					bclx::aput_sync(NULL_ERA, temp);	// local
 					return nullptr;
-				else // if (result != nullptr)
+				}
+
+				// val was reachable after era had been published, so it is
+				// protected if it was born no later than era
+				era_new = birth(val);
+				if (era_new <= era)
 				{
-					era_new = BCL::aget_sync(epoch);	// one RMA
-					if (era_new == era_old)
-					{
-						dictionary.push_back(std::make_pair(result, i));
-						return result;
-					}
-					else // if (era_new != era_old)
-					{
-						BCL::aput_sync(era_new, temp);
-						era_old = era_new;
-					}
+					reserved[i] = last_ptr = val;
+					last_era = era_new;
+					return val;
 				}
+				era = era_new;
+				bclx::aput_sync(era, temp);	// local
 			}
 		}
-		else // if (era_old != MIN)
+		else // if (reserved[i] != NULL_PTR)
 			++temp;
-	printf("HE:Error\n");
+	printf("[%lu]ERROR: memory.reserve\n", BCL::rank());
 	return nullptr;
 }
 
 template<typename T>
 void dds::he::memory<T>::unreserve(const gptr<T>& ptr)
 {
-	if (ptr == nullptr)
+	if (ptr == NULL_PTR)
 		return;
 	else // if (ptr != nullptr)
 	{
-		for (uint32_t i = 0; i < dictionary.size(); ++i)
-			if (dictionary[i].first == ptr)
+		gptr<uint64_t> temp = reservation;
+		for (uint32_t i = 0; i < HES_PER_UNIT; ++i)
+			if (reserved[i] == ptr)
 			{
-				gptr<uint64_t> temp = reservation + dictionary[i].second;
-				BCL::aput_sync(MIN, temp);
+				bclx::aput_sync(NULL_ERA, temp);	// local
+				reserved[i] = NULL_PTR;
 				return;
 			}
-		printf("HE:Error\n");
+			else // if (reserved[i] != ptr)
+				++temp;
+		printf("[%lu]ERROR: memory.unreserve\n", BCL::rank());
 		return;
 	}
 }
 
 template<typename T>
-void dds::he::memory<T>::empty()
+bclx::gptr<dds::he::block<T>> dds::he::memory<T>::to_block(const gptr<T>& ptr) const
+{
+	return {ptr.rank, ptr.ptr - OFFSET};
+}
+
+template<typename T>
+uint64_t dds::he::memory<T>::birth(const gptr<T>& ptr)
 {
-	bool			conflict;
-	uint64_t		he;
-	gptr<uint64_t> 		temp;
-	std::vector<uint64_t>	reservations;
+	gptr<uint64_t> temp = {ptr.rank, ptr.ptr - OFFSET};
+	return bclx::aget_sync(temp);	// one RMA
+}
 
-	reservations.reserve(BCL::nprocs() * HPS_PER_UNIT);
-	temp.ptr = reservation.ptr;
+template<typename T>
+void dds::he::memory<T>::empty()
+{
+	std::vector<uint64_t>	elist;		// contain the hazard eras of all units
+	std::vector<sblock<T>>	new_dlist;	// be dlist after finishing the Scan function
+	gptr<uint64_t>		he_temp;	// a temporary variable
+	sblock<T>		sb;		// a temporary variable
+
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
+	elist.resize(HE_TOTAL);
+	new_dlist.reserve(HE_TOTAL);
+
+	// Stage 1: get the hazard eras of each unit in one bulk get
+	he_temp.ptr = reservation.ptr;
 	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
 	{
-		temp.rank = i;
-		for (uint32_t j = 0; j < HPS_PER_UNIT; ++j)
-		{
-			he = BCL::aget_sync(temp);
-			if (he != MIN)
-				reservations.push_back(he);
-			++temp;
-		}
+		he_temp.rank = i;
+		bclx::aget_sync(he_temp, &elist[i * HES_PER_UNIT], HES_PER_UNIT);	// one RMA
 	}
 
-	for (uint64_t i = 0; i < list_ret.size(); ++i)
+	// Stage 2
+	std::sort(elist.begin(), elist.end());
+	elist.resize(std::unique(elist.begin(), elist.end()) - elist.begin());
+
+	// Stage 3: an elem is in use if some hazard era lies in [era_new, era_del]
+	while (!list_ret.empty())
 	{
-		conflict = false;
-		for (uint64_t j = 0; j < reservations.size(); ++j)
-			if (list_ret[i].era_new <= reservations[j] &&
-					reservations[j] <= list_ret[i].era_del)
-			{
-				conflict = true;
-				break;
-			}
+		sb = list_ret.back();
+		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
+		auto it = std::lower_bound(elist.begin(), elist.end(), sb.era_new);
+		if (it != elist.end() && *it <= sb.era_del)
+		{
+			new_dlist.push_back(sb);
 
-		if (!conflict)
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
+		else
 		{
 			// tracing
 			#ifdef	TRACING
 				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
 			#endif
 
-			list_rec.push_back(list_ret[i].ptr);
-			list_ret.erase(list_ret.begin() + i);
+			list_rec.push_back(sb.ptr);
 		}
-
 	}
+
+	// Stage 4
+	list_ret = std::move(new_dlist);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
 }
 
 #endif /* MEMORY_HE_H */
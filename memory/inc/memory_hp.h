@@ -19,7 +19,7 @@ using namespace bclx;
 template<typename T>
 struct list_seq2
 {
-	sds::list<T>		contig;
+	pool_list<T>		contig;
 	std::vector<gptr<T>>	ncontig;
 };
 
@@ -45,12 +45,16 @@ private:
         const uint64_t		HP_TOTAL	= BCL::nprocs() * HPS_PER_UNIT;
         const uint64_t		HP_WINDOW	= HP_TOTAL * 2;
 
-	sds::list<T>         	pool_mem;	// allocate global memory
+	pool_list<T>         	pool_mem;	// allocate global memory
 	gptr<T>         	pool_rep;	// deallocate global memory
 	gptr<gptr<T>>		reservation;	// be an array of hazard pointers of the calling unit
 	std::vector<gptr<T>>	list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>	list_ts;	// contain retire times of elems in list_ret
+	#endif
 	list_seq2<T>		lheap;		// be per-unit heap
 
+	uint64_t num_free() const;
 	void empty();
 };
 
@@ -71,7 +75,7 @@ dds::hp::memory<T>::memory()
 		++temp;
 	}
 
-	pool_rep = BCL::alloc<T>(TOTAL_OPS);
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
         if (pool_rep == nullptr)
 	{
 		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
@@ -98,6 +102,7 @@ bclx::gptr<T> dds::hp::memory<T>::malloc()
 		// tracing
 		#ifdef  TRACING
 			++elem_ru;
+			++mstats.reused;
 		#endif
 
 		// debugging
@@ -129,14 +134,14 @@ bclx::gptr<T> dds::hp::memory<T>::malloc()
 			++cnt_pool;
 		#endif
 
-		gptr<T> ptr = pool_mem.pop(HP_WINDOW);
-		lheap.contig.set(ptr, HP_WINDOW);
+		lheap.contig = pool_mem.pop(HP_WINDOW);
 
 		return lheap.contig.pop();
 	}
 
 	// try to reclaim global memory one more
-	empty();
+	if (!list_ret.empty())
+		empty();
 
 	// if lheap.ncontig is not empty, return a gptr<T> from it
 	if (!lheap.ncontig.empty())
@@ -144,6 +149,7 @@ bclx::gptr<T> dds::hp::memory<T>::malloc()
 		// tracing
 		#ifdef  TRACING
 			++elem_ru;
+			++mstats.reused;
 		#endif
 
 		gptr<T> ptr = lheap.ncontig.back();
@@ -151,8 +157,7 @@ bclx::gptr<T> dds::hp::memory<T>::malloc()
 		return ptr;
 	}
 
-	// otherwise, return nullptr
-	printf("[%lu]ERROR: memory.malloc\n", BCL::rank());
+	// otherwise, return nullptr to push back on the caller
 	return nullptr;
 }
 
@@ -171,7 +176,15 @@ void dds::hp::memory<T>::retire(const gptr<T>& ptr)
 	#endif
 
 	list_ret.push_back(ptr);
-	if (list_ret.size() >= HP_WINDOW)
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
+
+	// scan eagerly while free elems are below the low watermark
+	if (list_ret.size() >= HP_WINDOW || num_free() < WM_FREE_LOW)
 		empty();
 }
 
@@ -264,6 +277,12 @@ void dds::hp::memory<T>::unreserve(const gptr<T>& ptr)
 	}
 }
 
+template<typename T>
+uint64_t dds::hp::memory<T>::num_free() const
+{
+	return pool_mem.size() + lheap.contig.size() + lheap.ncontig.size();
+}
+
 template<typename T>
 void dds::hp::memory<T>::empty()
 {	
@@ -272,6 +291,13 @@ void dds::hp::memory<T>::empty()
 	gptr<gptr<T>> 		hp_temp;	// a temporary variable
 	gptr<T>			ptr;		// a temporary variable
 
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
 	plist.reserve(HP_TOTAL);
 	new_dlist.reserve(HP_TOTAL);
 
@@ -298,13 +324,28 @@ void dds::hp::memory<T>::empty()
 	{
 		ptr = list_ret.back();
 		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
 		if (std::binary_search(plist.begin(), plist.end(), ptr))
+		{
 			new_dlist.push_back(ptr);
+
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
 		else
 		{
 			// tracing
 			#ifdef	TRACING
 				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
 			#endif
 
 			free(ptr);
@@ -313,6 +354,14 @@ void dds::hp::memory<T>::empty()
 
 	// Stage 4
 	list_ret = std::move(new_dlist);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
 }
 
 #endif /* MEMORY_HP_H */
@@ -1,9 +1,10 @@
 #ifndef MEMORY_IBR_H
 #define MEMORY_IBR_H
 
-#include <cstdint>	// uint64_t...
-#include <vector>	// std::vector...
-#include <limits>	// std::numeric_limits...
+#include <cstdint>		// uint64_t...
+#include <cstddef>		// offsetof...
+#include <vector>		// std::vector...
+#include <utility>		// std::move...
 
 namespace dds
 {
@@ -11,27 +12,25 @@ namespace dds
 namespace ibr
 {
 
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
 template<typename T>
 struct block
 {
-	uint32_t	era_new;
+	uint64_t	era_new;	// be the birth era of elem
 	T		elem;
 };
 
 template<typename T>
 struct sblock
 {
-	uint32_t	era_new;
-	uint32_t	era_del;
+	uint64_t	era_new;
+	uint64_t	era_del;
 	gptr<block<T>>	ptr;
 };
 
-struct reser
-{
-	uint32_t	upper;
-	uint32_t	lower;
-};
-
 template<typename T>
 class memory
 {
@@ -40,25 +39,40 @@ public:
 	~memory();
 	gptr<T> malloc();			// allocate global memory
 	void free(const gptr<T>&);		// deallocate global memory
+	void retire(const gptr<T>&);		// retire a global pointer
 	void op_begin();			// indicate the beginning of a concurrent operation
 	void op_end();				// indicate the end of a concurrent operation
-	gptr<T> reserve(const gptr<gptr<T>>&);	// try to protect a global pointer from reclamation
+	bool try_reserve(const gptr<gptr<T>>&,	// try to protect a global pointer from reclamation
+			const gptr<T>&);
+	gptr<T> reserve(const gptr<gptr<T>>&);	// protect a global pointer from reclamation
 	void unreserve(const gptr<T>&);		// stop protecting a global pointer
 
 private:
-	const uint32_t		MIN		= std::numeric_limits<uint32_t>::min();
+	const gptr<T>		NULL_PTR 	= nullptr;
+	const uint64_t		NULL_ERA	= 0;
+	const uint64_t		OFFSET		= offsetof(block<T>, elem);
+	const uint32_t		LOWER		= 0;			// index of the lower era in reservation
+	const uint32_t		UPPER		= 1;			// index of the upper era in reservation
 	const uint64_t		EPOCH_FREQ	= BCL::nprocs();	// freq. of increasing epoch
 	const uint64_t		EMPTY_FREQ	= BCL::nprocs() * 2;	// freq. of reclaiming retired
 
-	gptr<block<T>>			pool;		// allocate PGAS
-	gptr<block<T>>			pool_rep;	// deallocate PGAS
-	uint64_t			capacity;	// contain global memory capacity (bytes)
-	gptr<uint32_t>			epoch;		// a global clock
-	gptr<reser>			reservation;	// contain the reserved things
-	uint64_t			counter;	// a local counter
+	pool_list<block<T>>		pool_mem;	// allocate global memory
+	gptr<block<T>>			pool_rep;	// deallocate global memory
+	gptr<uint64_t>			epoch;		// be a global clock
+	uint64_t			era_local;	// be the cached value of epoch
+	gptr<uint64_t>			reservation;	// be the reserved interval [lower, upper] of the calling unit
+	uint64_t			upper_local;	// be the cached value of the upper era
+	gptr<T>				last_ptr;	// be the last reserved elem
+	uint64_t			last_era;	// be the birth era of last_ptr
+	uint64_t			counter;	// be # allocations of the calling unit
 	std::vector<sblock<T>>		list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>		list_ts;	// contain retire times of elems in list_ret
+	#endif
 	std::vector<gptr<block<T>>>	list_rec;	// contain reclaimed elems
 
+	gptr<block<T>> to_block(const gptr<T>&) const;
+	uint64_t birth(const gptr<T>&);
 	void empty();
 };
 
@@ -69,20 +83,30 @@ private:
 template<typename T>
 dds::ibr::memory<T>::memory()
 {
-	epoch = BCL::alloc<uint32_t>(1);
+	epoch = BCL::alloc<uint64_t>(1);
 	if (BCL::rank() == MASTER_UNIT)
 	{
 		mem_manager = "IBR";
-		BCL::store(uint32_t(1), epoch);
+		bclx::store(uint64_t(1), epoch);
 	}
 	else // if (BCL::rank() != MASTER_UNIT)
 		epoch.rank = MASTER_UNIT;
+	era_local = 1;
 
-	reservation = BCL::alloc<reser>(1);
-	BCL::store({MIN, MIN}, reservation);
+	reservation = BCL::alloc<uint64_t>(2);
+	bclx::store(NULL_ERA, reservation + LOWER);
+	bclx::store(NULL_ERA, reservation + UPPER);
+	upper_local = NULL_ERA;
+	last_ptr = NULL_PTR;
+	last_era = NULL_ERA;
 
-	pool = pool_rep = BCL::alloc<block<T>>(TOTAL_OPS);
-	capacity = pool.ptr + TOTAL_OPS * sizeof(block<T>);
+	pool_rep = pool_alloc<block<T>>(TOTAL_OPS);
+        if (pool_rep == nullptr)
+	{
+		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
+		return;
+	}
+	pool_mem.set(pool_rep, TOTAL_OPS);
 
 	counter = 0;
 	list_ret.reserve(EMPTY_FREQ);
@@ -92,153 +116,251 @@ template<typename T>
 dds::ibr::memory<T>::~memory()
 {
 	BCL::dealloc<block<T>>(pool_rep);
-	BCL::dealloc<reser>(reservation);
+	BCL::dealloc<uint64_t>(reservation);
 	epoch.rank = BCL::rank();
-	BCL::dealloc<uint32_t>(epoch);
+	BCL::dealloc<uint64_t>(epoch);
 }
 
 template<typename T>
-dds::gptr<T> dds::ibr::memory<T>::malloc()
+bclx::gptr<T> dds::ibr::memory<T>::malloc()
 {
+	gptr<block<T>> addr;
+
+	// advance the global clock periodically, refreshing the cached era
 	++counter;
 	if (counter % EPOCH_FREQ == 0)
-		BCL::fao_sync(epoch, uint32_t(1), BCL::plus<uint32_t>{});	// one RMA
+		era_local = bclx::fao_sync(epoch, uint64_t(1), BCL::plus<uint64_t>{}) + 1;	// one RMA
 
-	// determine the global address of the new element
+	// if list_rec is not empty, return a gptr<T> from it
 	if (!list_rec.empty())
 	{
 		// tracing
 		#ifdef  TRACING
-			elem_ru++;
+			++elem_ru;
+			++mstats.reused;
 		#endif
 
-		gptr<block<T>> addr = list_rec.back();
+		addr = list_rec.back();
 		list_rec.pop_back();
-		gptr<uint32_t> temp = {addr.rank, addr.ptr};
-		uint32_t timestamp = aget_sync(epoch);	// one RMA
-		BCL::rput_sync(timestamp, temp);	// one RMA
-		return {addr.rank, addr.ptr + sizeof(addr.rank)};
 	}
-	else // the list of reclaimed global empty is empty
+
+	// otherwise, get an elem from the memory pool
+	else if (!pool_mem.empty())
+		addr = pool_mem.pop();
+
+	// otherwise, try to reclaim global memory one more
+	else
 	{
-		if (pool.ptr < capacity)
-		{
-			gptr<T> addr = {pool.rank, pool.ptr + sizeof(pool.rank)};
-			gptr<uint32_t> temp = {pool.rank, pool.ptr};
-			uint32_t timestamp = aget_sync(epoch);	// one RMA
-			BCL::store(timestamp, temp);
-			++pool;
-			return addr;
-		}
-		else // if (pool.ptr == capacity)
-		{
-			empty();
-			if (!list_rec.empty())
-			{
-				// tracing
-				#ifdef  TRACING
-					elem_ru++;
-				#endif
-
-				gptr<block<T>> addr = list_rec.back();
-				list_rec.pop_back();
-				gptr<uint32_t> temp = {addr.rank, addr.ptr};
-				uint32_t timestamp = aget_sync(epoch);	// one RMA
-				BCL::rput_sync(timestamp, temp);	// one RMA
-				return {addr.rank, addr.ptr + sizeof(addr.rank)};
-			}
-		}
+		empty();
+		if (list_rec.empty())
+			return nullptr;
+
+		// tracing
+		#ifdef  TRACING
+			++elem_ru;
+			++mstats.reused;
+		#endif
+
+		addr = list_rec.back();
+		list_rec.pop_back();
 	}
-	return nullptr;
+
+	// stamp the birth era of the new elem with the cached era
+	gptr<uint64_t> temp = {addr.rank, addr.ptr};
+	if (addr.rank == BCL::rank())
+		bclx::store(era_local, temp);
+	else // if (addr.rank != BCL::rank())
+		bclx::rput_sync(era_local, temp);	// one RMA
+	return {addr.rank, addr.ptr + OFFSET};
 }
 
 template<typename T>
 void dds::ibr::memory<T>::free(const gptr<T>& ptr)
 {
-	gptr<block<T>> temp = {ptr.rank, ptr.ptr - sizeof(ptr.rank)};
-	gptr<uint32_t> temp2 = {temp.rank, temp.ptr};
-	uint32_t era_new = BCL::rget_sync(temp2);	// one RMA
-	uint32_t era_del = BCL::aget_sync(epoch);	// one RMA
-	list_ret.push_back({era_new, era_del, temp});
-	if (list_ret.size() % EMPTY_FREQ == 0)
+	list_rec.push_back(to_block(ptr));
+}
+
+template<typename T>
+void dds::ibr::memory<T>::retire(const gptr<T>& ptr)
+{
+	uint64_t era_new = (ptr == last_ptr) ? last_era : birth(ptr);
+	era_local = bclx::aget_sync(epoch);	// one RMA
+	list_ret.push_back({era_new, era_local, to_block(ptr)});
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
+
+	if (list_ret.size() >= EMPTY_FREQ)
 		empty();
 }
 
 template<typename T>
 void dds::ibr::memory<T>::op_begin()
 {
-	uint32_t timestamp = BCL::aget_sync(epoch);	// one RMA
-	BCL::aput_sync({timestamp, timestamp}, reservation);
+	// reserve [era_local, era_local] without contacting the global clock
+	upper_local = era_local;
+	bclx::aput_sync(upper_local, reservation + UPPER);	// local
+	bclx::aput_sync(upper_local, reservation + LOWER);	// local
 }
 
 template<typename T>
 void dds::ibr::memory<T>::op_end()
 {
-	BCL::aput_sync({MIN, MIN}, reservation);
+	bclx::aput_sync(NULL_ERA, reservation + LOWER);	// local
+}
+
+template<typename T>
+bool dds::ibr::memory<T>::try_reserve(const gptr<gptr<T>>& ptr, const gptr<T>& val_old)
+{
+	uint64_t era_new;
+
+	if (val_old == NULL_PTR)
+		return false;
+	while (true)
+	{
+		if (bclx::aget_sync(ptr) != val_old)	// one RMA
+			return false;
+		era_new = birth(val_old);
+		if (era_new <= upper_local)
+		{
+			last_ptr = val_old;
+			last_era = era_new;
+			return true;
+		}
+		upper_local = era_new;
+		bclx::aput_sync(upper_local, reservation + UPPER);	// local
+	}
 }
 
 template<typename T>
-dds::gptr<T> dds::ibr::memory<T>::reserve(const gptr<gptr<T>>& ptr)
+bclx::gptr<T> dds::ibr::memory<T>::reserve(const gptr<gptr<T>>& ptr)
 {
-	gptr<T>		result;
-	uint32_t	timestamp;
-	gptr<uint32_t>	upper = {reservation.rank, reservation.ptr};
+	uint64_t	era_new;
+	gptr<T>		val;
+
 	while (true)
 	{
-		result = aget_sync(ptr);	// one RMA
-		if (result == nullptr)
+		val = bclx::aget_sync(ptr);	// one RMA
+		if (val == NULL_PTR)
 			return nullptr;
-		else // if (result != nullptr)
+
+		// val was reachable during the operation, so it is
+		// protected if it was born no later than the upper era
+		era_new = birth(val);
+		if (era_new <= upper_local)
 		{
-			timestamp = aget_sync(epoch);	// one RMA
-			if (aget_sync(upper) < timestamp)
-				aput_sync(timestamp, upper);
-			timestamp = aget_sync(epoch);	// one RMA
-			if (aget_sync(upper) == timestamp)
-				return result;
+			last_ptr = val;
+			last_era = era_new;
+			return val;
 		}
+		upper_local = era_new;
+		bclx::aput_sync(upper_local, reservation + UPPER);	// local
 	}
 }
 
 template<typename T>
-void dds::ibr::memory<T>::unreserve(const gptr<T>& ptr)
+void dds::ibr::memory<T>::unreserve(const gptr<T>&) {}
+
+template<typename T>
+bclx::gptr<dds::ibr::block<T>> dds::ibr::memory<T>::to_block(const gptr<T>& ptr) const
+{
+	return {ptr.rank, ptr.ptr - OFFSET};
+}
+
+template<typename T>
+uint64_t dds::ibr::memory<T>::birth(const gptr<T>& ptr)
 {
-	/* No-op */
+	gptr<uint64_t> temp = {ptr.rank, ptr.ptr - OFFSET};
+	return bclx::aget_sync(temp);	// one RMA
 }
 
 template<typename T>
 void dds::ibr::memory<T>::empty()
 {
-	std::vector<reser>	reservations;
-	gptr<reser>		temp = reservation;
-	reser			value;
-	reservations.reserve(BCL::nprocs());
+	std::vector<uint64_t>	rlist;		// contain the reserved intervals of all units
+	std::vector<sblock<T>>	new_dlist;	// be dlist after finishing the Scan function
+	gptr<uint64_t>		r_temp;		// a temporary variable
+	sblock<T>		sb;		// a temporary variable
+	bool			conflict;	// a temporary variable
+
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
+	rlist.resize(BCL::nprocs() * 2);
+	new_dlist.reserve(BCL::nprocs());
 
+	// Stage 1: advance the global clock so that the interval of the calling
+	// unit no longer covers the elems it retired before its current operation
+	era_local = bclx::fao_sync(epoch, uint64_t(1), BCL::plus<uint64_t>{}) + 1;	// one RMA
+
+	// Stage 2: get the reserved interval of each unit in one bulk get
+	r_temp.ptr = reservation.ptr;
 	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
 	{
-		temp.rank = i;
-		value = BCL::aget_sync(temp);	// one RMA
-		reservations.push_back(value);
+		r_temp.rank = i;
+		bclx::aget_sync(r_temp, &rlist[i * 2], 2);	// one RMA
 	}
 
-	bool conflict = false;
-	for (uint64_t i = 0; i < list_ret.size(); ++i)
+	// Stage 3: an elem is in use if [era_new, era_del] overlaps an active interval
+	while (!list_ret.empty())
 	{
-		for (uint64_t j = 0; j < reservations.size(); ++j)
-			if (list_ret[i].era_new <= reservations[j].upper &&
-				list_ret[i].era_del >= reservations[j].lower)
-					conflict = true;
-		if (!conflict)
+		sb = list_ret.back();
+		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
+		conflict = false;
+		for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+			if (rlist[i * 2 + LOWER] != NULL_ERA &&
+					sb.era_new <= rlist[i * 2 + UPPER] &&
+					sb.era_del >= rlist[i * 2 + LOWER])
+			{
+				conflict = true;
+				break;
+			}
+
+		if (conflict)
+		{
+			new_dlist.push_back(sb);
+
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
+		else
 		{
 			// tracing
 			#ifdef	TRACING
 				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
 			#endif
 
-			list_rec.push_back(list_ret[i].ptr);		
-			list_ret.erase(list_ret.begin() + i);
+			list_rec.push_back(sb.ptr);
 		}
 	}
+
+	// Stage 4
+	list_ret = std::move(new_dlist);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
 }
 
 #endif /* MEMORY_IBR_H */
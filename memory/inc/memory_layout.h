@@ -0,0 +1,108 @@
+#ifndef MEMORY_LAYOUT_H
+#define MEMORY_LAYOUT_H
+
+#include <cstdint>	// uint64_t...
+
+namespace dds
+{
+
+/* Constants */
+const uint64_t	CACHE_LINE	= 64;	// bytes
+
+/* Datatypes */
+// the layout of the elems carved out of a memory pool. By default, elems are
+// packed back to back, so that several small elems share a cache line, and an
+// rget of one of them contends with the CAS and puts of units working on its
+// neighbors. With ELEM_PADDED, every elem starts a cache line of its own (BCL
+// aligns every allocation to one), so that an elem of a gptr and a value up to
+// 56 B fits in exactly one line, and a larger one in whole lines
+template<typename T>
+struct layout
+{
+#ifdef	ELEM_PADDED
+	static const uint64_t	ALIGN	= (alignof(T) > CACHE_LINE) ? alignof(T) : CACHE_LINE;
+#else
+	static const uint64_t	ALIGN	= alignof(T);
+#endif
+	static const uint64_t	STRIDE	= (sizeof(T) + ALIGN - 1) / ALIGN * ALIGN;	// be # bytes between two elems
+};
+
+// a run of contiguous elems of a memory pool, handed out in order
+template<typename T>
+class pool_list
+{
+public:
+	pool_list();
+	~pool_list();
+	void set(const bclx::gptr<T> &ptr, const uint64_t &num);	// take # elems from ptr on
+	bool empty() const;
+	uint64_t size() const;
+	bclx::gptr<T> pop();						// take the first elem (nullptr if empty)
+	pool_list<T> pop(const uint64_t &num);				// take the first # elems (at most all those left)
+
+private:
+	bclx::gptr<T>	head;	// be the first elem left
+	uint64_t	len;	// be # elems left
+};
+
+/* Functions */
+template<typename T>
+bclx::gptr<T> pool_alloc(const uint64_t &num);	// allocate a pool of # elems laid out by layout<T>
+
+} /* namespace dds */
+
+template<typename T>
+dds::pool_list<T>::pool_list()
+	: head{nullptr}, len{0} {}
+
+template<typename T>
+dds::pool_list<T>::~pool_list() {}
+
+template<typename T>
+void dds::pool_list<T>::set(const bclx::gptr<T> &ptr, const uint64_t &num)
+{
+	head = ptr;
+	len = num;
+}
+
+template<typename T>
+bool dds::pool_list<T>::empty() const
+{
+	return len == 0;
+}
+
+template<typename T>
+uint64_t dds::pool_list<T>::size() const
+{
+	return len;
+}
+
+template<typename T>
+bclx::gptr<T> dds::pool_list<T>::pop()
+{
+	if (len == 0)
+		return nullptr;
+	return pop(1).head;
+}
+
+template<typename T>
+dds::pool_list<T> dds::pool_list<T>::pop(const uint64_t &num)
+{
+	pool_list<T>	run;
+
+	run.set(head, (num < len) ? num : len);
+	head.ptr += run.len * layout<T>::STRIDE;
+	len -= run.len;
+	return run;
+}
+
+template<typename T>
+bclx::gptr<T> dds::pool_alloc(const uint64_t &num)
+{
+	bclx::gptr<char> ptr = BCL::alloc<char>(num * layout<T>::STRIDE);
+	if (ptr == nullptr)
+		return nullptr;
+	return {ptr.rank, ptr.ptr};
+}
+
+#endif /* MEMORY_LAYOUT_H */
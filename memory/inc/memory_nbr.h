@@ -0,0 +1,341 @@
+#ifndef MEMORY_NBR_H
+#define MEMORY_NBR_H
+
+#include <cstdint>		// uint64_t...
+#include <vector>		// std::vector...
+#include <algorithm>		// std::sort...
+#include <utility>		// std::move...
+
+namespace dds
+{
+
+namespace nbr
+{
+
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
+template<typename T>
+struct list_seq2
+{
+	pool_list<T>		contig;
+	std::vector<gptr<T>>	ncontig;
+};
+
+template<typename T>
+class memory
+{
+public:
+	memory();
+	~memory();
+	gptr<T> malloc();			// allocate global memory
+	void free(const gptr<T>&);		// deallocate global memory
+	void retire(const gptr<T>&);		// retire a global pointer
+	void op_begin();			// indicate the beginning of a concurrent operation (read phase)
+	void op_end();				// indicate the end of a concurrent operation
+	bool try_reserve(const gptr<gptr<T>>&,	// enter the write phase by protecting a global pointer
+			const gptr<T>&);
+	gptr<T> reserve(const gptr<gptr<T>>&);	// read a global pointer in the read phase (no publication)
+	void unreserve(const gptr<T>&);		// stop protecting a global pointer
+	bool neutralized();			// check if the calling unit has been neutralized
+
+private:
+	const gptr<T>		NULL_PTR 	= nullptr;
+        const uint32_t		HPS_PER_UNIT 	= 1;
+        const uint64_t		HP_TOTAL	= BCL::nprocs() * HPS_PER_UNIT;
+        const uint64_t		HP_WINDOW	= HP_TOTAL * 2;
+
+	pool_list<T>         	pool_mem;	// allocate global memory
+	gptr<T>         	pool_rep;	// deallocate global memory
+	gptr<gptr<T>>		reservation;	// be an array of write-phase reservations of the calling unit
+	gptr<uint64_t>		signal;		// be a neutralization counter of the calling unit
+	uint64_t		signal_local;	// be the value of signal at the beginning of the read phase
+	std::vector<gptr<T>>	list_ret;	// contain retired elems
+	#ifdef	TRACING
+	std::vector<double>	list_ts;	// contain retire times of elems in list_ret
+	#endif
+	list_seq2<T>		lheap;		// be per-unit heap
+
+	void empty();
+};
+
+} /* namespace nbr */
+
+} /* namespace dds */
+
+template<typename T>
+dds::nbr::memory<T>::memory()
+{
+	if (BCL::rank() == MASTER_UNIT)
+		mem_manager = "NBR";
+
+        gptr<gptr<T>> temp = reservation = BCL::alloc<gptr<T>>(HPS_PER_UNIT);
+	for (uint32_t i = 0; i < HPS_PER_UNIT; ++i)
+	{
+		bclx::store(NULL_PTR, temp);
+		++temp;
+	}
+
+	signal = BCL::alloc<uint64_t>(1);
+	signal_local = 0;
+	bclx::store(signal_local, signal);
+
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
+        if (pool_rep == nullptr)
+	{
+		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
+		return;
+	}
+	pool_mem.set(pool_rep, TOTAL_OPS);
+
+	list_ret.reserve(HP_WINDOW);
+}
+
+template<typename T>
+dds::nbr::memory<T>::~memory()
+{
+        BCL::dealloc<T>(pool_rep);
+	BCL::dealloc<uint64_t>(signal);
+	BCL::dealloc<gptr<T>>(reservation);
+}
+
+template<typename T>
+bclx::gptr<T> dds::nbr::memory<T>::malloc()
+{
+	// if lheap.ncontig is not empty, return a gptr<T> from it
+	if (!lheap.ncontig.empty())
+	{
+		// tracing
+		#ifdef  TRACING
+			++elem_ru;
+			++mstats.reused;
+		#endif
+
+		gptr<T> ptr = lheap.ncontig.back();
+		lheap.ncontig.pop_back();
+		return ptr;
+	}
+
+	// if lheap.contig is not empty, return a gptr<T> from it
+	if (!lheap.contig.empty())
+	{
+		return lheap.contig.pop();
+	}
+
+	// otherwise, get elems from the memory pool
+	if (!pool_mem.empty())
+	{
+		lheap.contig = pool_mem.pop(HP_WINDOW);
+
+		return lheap.contig.pop();
+	}
+
+	// try to reclaim global memory one more
+	if (!list_ret.empty())
+		empty();
+
+	// if lheap.ncontig is not empty, return a gptr<T> from it
+	if (!lheap.ncontig.empty())
+	{
+		// tracing
+		#ifdef  TRACING
+			++elem_ru;
+			++mstats.reused;
+		#endif
+
+		gptr<T> ptr = lheap.ncontig.back();
+		lheap.ncontig.pop_back();
+		return ptr;
+	}
+
+	// otherwise, return nullptr to push back on the caller
+	return nullptr;
+}
+
+template<typename T>
+void dds::nbr::memory<T>::free(const gptr<T>& ptr)
+{
+	lheap.ncontig.push_back(ptr);
+}
+
+template<typename T>
+void dds::nbr::memory<T>::retire(const gptr<T>& ptr)
+{
+	list_ret.push_back(ptr);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts.push_back(MPI_Wtime());
+		++mstats.retired;
+	#endif
+	if (list_ret.size() >= HP_WINDOW)
+		empty();
+}
+
+template<typename T>
+void dds::nbr::memory<T>::op_begin()
+{
+	// begin the read phase
+	signal_local = bclx::aget_sync(signal);	// local
+}
+
+template<typename T>
+void dds::nbr::memory<T>::op_end() {}
+
+template<typename T>
+bool dds::nbr::memory<T>::try_reserve(const gptr<gptr<T>>&, const gptr<T>& val_old)
+{
+	if (val_old == NULL_PTR)
+		return false;
+	else // if (val_old != NULL_PTR)
+	{
+		gptr<gptr<T>> temp = reservation;
+		for (uint32_t i = 0; i < HPS_PER_UNIT; ++i)
+			if (bclx::aget_sync(temp) == NULL_PTR)
+			{
+				bclx::aput_sync(val_old, temp);	// local
+
+				// if a reclaimer has neutralized the calling unit since
+				// the read phase began, whatever was read may be stale
+				if (neutralized())
+				{
+					bclx::aput_sync(NULL_PTR, temp);	// local
+					op_begin();	// restart the read phase
+					return false;
+				}
+				return true;
+			}
+			else // if (bclx::aget_sync(temp) != NULL_PTR)
+				++temp;
+		printf("[%lu]ERROR: memory.try_reserve\n", BCL::rank());
+		return false;
+	}
+}
+
+template<typename T>
+bclx::gptr<T> dds::nbr::memory<T>::reserve(const gptr<gptr<T>>& ptr)
+{
+	return bclx::aget_sync(ptr);	// one RMA
+}
+
+template<typename T>
+void dds::nbr::memory<T>::unreserve(const gptr<T>& ptr)
+{
+	if (ptr == NULL_PTR)
+		return;
+	else // if (ptr != nullptr)
+	{
+		gptr<gptr<T>> temp = reservation;
+		for (uint32_t i = 0; i < HPS_PER_UNIT; ++i)
+			if (bclx::aget_sync(temp) == ptr)
+			{
+				bclx::aput_sync(NULL_PTR, temp);	// local
+				return;
+			}
+			else // if (bclx::aget_sync(temp) != ptr)
+				++temp;
+
+		// a read-phase pointer was never published
+		return;
+	}
+}
+
+template<typename T>
+bool dds::nbr::memory<T>::neutralized()
+{
+	return bclx::aget_sync(signal) != signal_local;	// local
+}
+
+template<typename T>
+void dds::nbr::memory<T>::empty()
+{
+	std::vector<gptr<T>>	plist;		// contain non-null reservations
+	std::vector<gptr<T>>	new_dlist;	// be dlist after finishing the Scan function
+	gptr<gptr<T>> 		hp_temp;	// a temporary variable
+	gptr<uint64_t>		sig_temp;	// a temporary variable
+	gptr<T>			ptr;		// a temporary variable
+
+	// tracing
+	#ifdef	TRACING
+		std::vector<double>	new_tlist;
+		double			time_start = MPI_Wtime();
+		double			time_ret;
+	#endif
+
+	plist.reserve(HP_TOTAL);
+	new_dlist.reserve(HP_TOTAL);
+
+	// Stage 1: neutralize all other units
+	sig_temp.ptr = signal.ptr;
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (i != BCL::rank())
+		{
+			sig_temp.rank = i;
+			bclx::fao_sync(sig_temp, uint64_t(1), BCL::plus<uint64_t>{});	// one RMA
+		}
+
+	// Stage 2: collect reservations of units in their write phases
+	hp_temp.ptr = reservation.ptr;
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		hp_temp.rank = i;
+		for (uint32_t j = 0; j < HPS_PER_UNIT; ++j)
+		{
+			ptr = bclx::aget_sync(hp_temp);
+			if (ptr != NULL_PTR)
+				plist.push_back(ptr);
+			++hp_temp;
+		}
+	}
+
+	// Stage 3
+	std::sort(plist.begin(), plist.end());
+	plist.resize(std::unique(plist.begin(), plist.end()) - plist.begin());
+
+	// Stage 4
+        while (!list_ret.empty())
+	{
+		ptr = list_ret.back();
+		list_ret.pop_back();
+
+		// tracing
+		#ifdef	TRACING
+			time_ret = list_ts.back();
+			list_ts.pop_back();
+		#endif
+
+		if (std::binary_search(plist.begin(), plist.end(), ptr))
+		{
+			new_dlist.push_back(ptr);
+
+			// tracing
+			#ifdef	TRACING
+				new_tlist.push_back(time_ret);
+			#endif
+		}
+		else
+		{
+			// tracing
+			#ifdef	TRACING
+				++elem_rc;
+				mstats.record(MPI_Wtime() - time_ret);
+			#endif
+
+			free(ptr);
+		}
+	}
+
+	// Stage 5
+	list_ret = std::move(new_dlist);
+
+	// tracing
+	#ifdef	TRACING
+		list_ts = std::move(new_tlist);
+		++mstats.scans;
+		mstats.scan_time += MPI_Wtime() - time_start;
+		mstats.backlog = list_ret.size();
+	#endif
+}
+
+#endif /* MEMORY_NBR_H */
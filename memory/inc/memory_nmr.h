@@ -33,9 +33,9 @@ public:
 private:
 	const uint64_t	WINDOW = 2 * BCL::nprocs();
 
-	sds::list<T>	pool_mem;		// allocate global memory
+	pool_list<T>	pool_mem;		// allocate global memory
 	gptr<T>		pool_rep;		// deallocate global memory
-	sds::list<T>	lheap;			// be per-unit heap
+	pool_list<T>	lheap;			// be per-unit heap
 };
 
 } /* namespace nmr */
@@ -48,7 +48,7 @@ dds::nmr::memory<T>::memory()
 	if (BCL::rank() == MASTER_UNIT)
 		mem_manager = "NMR";
 
-	pool_rep = BCL::alloc<T>(TOTAL_OPS);
+	pool_rep = pool_alloc<T>(TOTAL_OPS);
 	if (pool_rep == nullptr)
 	{
 		printf("[%lu]ERROR: memory.memory\n", BCL::rank());
@@ -73,8 +73,7 @@ bclx::gptr<T> dds::nmr::memory<T>::malloc()
 	// otherwise, get elems from the memory pool
 	if (!pool_mem.empty())
 	{
-		gptr<T> ptr = pool_mem.pop(WINDOW);
-		lheap.set(ptr, WINDOW);
+		lheap = pool_mem.pop(WINDOW);
 		
 		return lheap.pop();
 	}
@@ -0,0 +1,74 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <cstdint>	// uint64_t...
+#include <cstdio>	// printf...
+
+namespace dds
+{
+
+/* Datatypes */
+class mem_stats
+{
+public:
+	uint64_t		scans;		// # scans of retired elems
+	double			scan_time;	// total time spent scanning (s)
+	uint64_t		retired;	// # retired elems
+	uint64_t		reclaimed;	// # reclaimed elems
+	uint64_t		reused;		// # reused elems
+	uint64_t		backlog;	// # retired but not yet reclaimed elems
+	bclx::histogram		hist;		// retire-to-free latencies (ns)
+
+	mem_stats();
+	void record(const double &latency);			// record a retire-to-free latency (s)
+	double percentile(const double &p) const;		// estimate a retire-to-free latency percentile (us)
+	mem_stats reduce(const MPI_Comm &comm,			// aggregate the stats of all units in a communicator
+			const int &root) const;
+	void print(const char *label) const;			// print the stats
+};
+
+/* Variables */
+#ifdef	TRACING
+	mem_stats	mstats;		// be the stats of the memory manager of the calling unit
+#endif
+
+} /* namespace dds */
+
+dds::mem_stats::mem_stats()
+	: scans{0}, scan_time{0}, retired{0}, reclaimed{0}, reused{0}, backlog{0} {}
+
+void dds::mem_stats::record(const double &latency)
+{
+	hist.record(uint64_t(latency * 1000000000));
+	++reclaimed;
+}
+
+double dds::mem_stats::percentile(const double &p) const
+{
+	return hist.percentile(p) / 1000.0;
+}
+
+dds::mem_stats dds::mem_stats::reduce(const MPI_Comm &comm, const int &root) const
+{
+	mem_stats	res;
+
+	MPI_Reduce(&scans, &res.scans, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&scan_time, &res.scan_time, 1, MPI_DOUBLE, MPI_SUM, root, comm);
+	MPI_Reduce(&retired, &res.retired, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&reclaimed, &res.reclaimed, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&reused, &res.reused, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	MPI_Reduce(&backlog, &res.backlog, 1, MPI_UINT64_T, MPI_SUM, root, comm);
+	res.hist = hist.reduce(comm, root);
+
+	return res;
+}
+
+void dds::mem_stats::print(const char *label) const
+{
+	printf("%s%lu scans, %f (s), %lu retired, %lu reclaimed, %lu reused, %lu backlog, "
+			"p50 %.1f (us), p99 %.1f (us), p999 %.1f (us)\n",
+			label, scans, scan_time, retired, reclaimed, reused, backlog,
+			percentile(50), percentile(99), percentile(99.9));
+}
+
+#endif /* MEMORY_STATS_H */
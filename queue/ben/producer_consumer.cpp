@@ -0,0 +1,105 @@
+#include <thread>			// std::this_thread...
+#include <chrono>			// std::chrono...
+#include <cstdint>			// uint32_t...
+#include <bclx/bclx.hpp>		// BCL::init...
+#include "../inc/queue.h"		// dds::queue...
+
+using namespace dds;
+
+int main()
+{
+        uint32_t 	i;
+	uint32_t	value;
+	uint64_t	num_ops,
+			empty = 0;
+	double		elapsed_time,
+			total_time;
+	bclx::timer	tim;
+
+        BCL::init();
+
+	if (BCL::nprocs() % 2 != 0)
+	{
+		printf("ERROR: The number of units must be even!\n");
+		return -1;
+	}
+
+        msq::queue<uint32_t> myQueue(TOTAL_OPS / 2);
+	num_ops = TOTAL_OPS / BCL::nprocs();
+
+	tim.start();	// start the timer
+
+	if (BCL::rank() % 2 == 0)
+	{
+		for (i = 0; i < num_ops; ++i)
+		{
+			// debugging
+			#ifdef DEBUGGING
+               			printf ("[%lu]%u\n", BCL::rank(), i);
+			#endif
+
+			myQueue.enqueue(i);
+			std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+		}
+	}
+	else // if (BCL::rank() % 2 != 0)
+		for (i = 0; i < num_ops; ++i)
+		{
+                        // debugging
+			#ifdef DEBUGGING
+                        	printf ("[%lu]%u\n", BCL::rank(), i);
+			#endif
+
+			if (!myQueue.dequeue(value))
+				++empty;
+			std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+		}
+
+	tim.stop();	// stop the timer
+
+	elapsed_time = tim.get() - ((double) num_ops * WORKLOAD) / 1000000;
+
+	total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+	empty = bclx::reduce(empty, MASTER_UNIT, BCL::sum<uint64_t>{});
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		printf("*********************************************************\n");
+		printf("*\tBENCHMARK\t:\tProducer-consumer\t*\n");
+		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+		printf("*\tNUM_OPS\t\t:\t%lu (ops/unit)\t\t*\n", num_ops);
+		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+		printf("*\tQUEUE\t\t:\t%s\t\t\t*\n", queue_name.c_str());
+		printf("*\tMEMORY\t\t:\t%s\t\t\t*\n", mem_manager.c_str());
+		printf("*\tEXEC_TIME\t:\t%f (s)\t\t*\n", total_time);
+		printf("*\tTHROUGHPUT\t:\t%f (ops/s)\t*\n", TOTAL_OPS / total_time);
+		printf("*\tEMPTY_DEQS\t:\t%lu\t\t\t*\n", empty);
+                printf("*********************************************************\n");
+	}
+
+	//tracing
+	#ifdef  TRACING
+		uint64_t	total_succ_cs = bclx::reduce(succ_cs, MASTER_UNIT, BCL::sum<uint64_t>{}),
+				total_fail_cs = bclx::reduce(fail_cs, MASTER_UNIT, BCL::sum<uint64_t>{}),
+				total_elem_rc = bclx::reduce(elem_rc, MASTER_UNIT, BCL::sum<uint64_t>{}),
+				total_elem_ru = bclx::reduce(elem_ru, MASTER_UNIT, BCL::sum<uint64_t>{});
+		double		total_fail_time = bclx::reduce(fail_time, MASTER_UNIT, BCL::max<double>{});
+		mem_stats	total_mstats = mstats.reduce(BCL::comm, MASTER_UNIT);
+
+		printf("[Proc %lu]%f (s), %f (s), %lu, %lu, %lu, %lu\n",
+				BCL::rank(), elapsed_time, fail_time,
+				succ_cs, fail_cs,
+				elem_rc, elem_ru);
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			printf("[TOTAL]%f (s), %lu, %lu, %lu, %lu\n",
+					total_fail_time,
+					total_succ_cs, total_fail_cs,
+					total_elem_rc, total_elem_ru);
+			total_mstats.print("[TOTAL]");
+		}
+	#endif
+
+	BCL::finalize();
+
+	return 0;
+}
@@ -0,0 +1,263 @@
+#include <random>			// std::mt19937...
+#include <cstdint>			// uint32_t...
+#include <string>			// std::string...
+#include <vector>			// std::vector...
+#include <algorithm>			// std::sort...
+#include <unordered_map>		// std::unordered_map...
+#include <bclx/bclx.hpp>		// BCL::init...
+#include "../inc/queue.h"		// dds::mq...
+
+using namespace dds;
+
+/* Datatypes */
+// an op of the history replayed against the sequential reference
+struct record
+{
+	uint64_t	key;	// be the inserted or deleted key
+	uint64_t	value;	// be the inserted or deleted value
+	uint64_t	end;	// be the response time (ns)
+	uint32_t	op;	// be 0 for an insert, 1 for a delete-min
+	uint32_t	status;	// be the result of the op
+};
+
+const uint32_t	INS	= 0;
+const uint32_t	DEL	= 1;
+
+// replay a complete history in the real-time order of its responses against a
+// sequential priority queue, and record the rank error of every delete-min: the
+// # keys in the reference that are smaller than the deleted one. A value that is
+// deleted before the response of its insert is taken out of the reference early
+void replay(const std::vector<record> &hist, bclx::histogram &rank_err,
+		uint64_t &fresh, uint64_t &repeated, uint64_t &lost)
+{
+	std::vector<record>			ins,
+						order(hist);
+	std::unordered_map<uint64_t, uint64_t>	index;		// map a value to its position in key order
+	std::vector<uint64_t>			tree;		// count the keys in the reference (Fenwick tree)
+	std::vector<uint32_t>			state;		// be 0 before, 1 in, 2 after the reference
+	uint64_t				i,
+						j,
+						smaller;
+
+	for (const record &r : hist)
+		if (r.op == INS && r.status)
+			ins.push_back(r);
+	std::sort(ins.begin(), ins.end(), [](const record &a, const record &b)
+			{ return (a.key != b.key) ? a.key < b.key : a.value < b.value; });
+	for (i = 0; i < ins.size(); ++i)
+		index[ins[i].value] = i;
+	tree.assign(ins.size() + 1, 0);
+	state.assign(ins.size(), 0);
+
+	auto add = [&tree](uint64_t k, const int64_t &delta)
+	{
+		for (++k; k < tree.size(); k += k & (~k + 1))
+			tree[k] += delta;
+	};
+	auto count = [&tree](uint64_t k)	// # keys of the reference before k
+	{
+		uint64_t sum = 0;
+		for (; k > 0; k -= k & (~k + 1))
+			sum += tree[k];
+		return sum;
+	};
+
+	std::stable_sort(order.begin(), order.end(), [](const record &a, const record &b)
+			{ return a.end < b.end; });
+	fresh = repeated = lost = 0;
+	for (const record &r : order)
+	{
+		if (!r.status)
+			continue;
+		auto it = index.find(r.value);
+		if (it == index.end())
+		{
+			++fresh;
+			continue;
+		}
+		j = it->second;
+		if (r.op == INS)
+		{
+			if (state[j] == 0)
+			{
+				state[j] = 1;
+				add(j, 1);
+			}
+		}
+		else if (state[j] == 2)
+			++repeated;
+		else
+		{
+			smaller = count(j);
+			if (state[j] == 1)
+				add(j, -1);
+			state[j] = 2;
+			rank_err.record(smaller);
+		}
+	}
+	for (i = 0; i < state.size(); ++i)
+		if (state[i] != 2)
+			++lost;
+}
+
+// gather the histories of every unit to MASTER_UNIT
+std::vector<record> gather(const std::vector<record> &hist)
+{
+	std::vector<record>	all;
+	std::vector<int>	counts(BCL::nprocs()),
+				displs(BCL::nprocs());
+	int			count = hist.size() * sizeof(record),
+				total = 0;
+
+	MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MASTER_UNIT, BCL::comm);
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		displs[i] = total;
+		total += counts[i];
+	}
+	if (BCL::rank() == MASTER_UNIT)
+		all.resize(total / sizeof(record));
+	MPI_Gatherv(hist.data(), count, MPI_BYTE, all.data(), counts.data(), displs.data(),
+			MPI_BYTE, MASTER_UNIT, BCL::comm);
+	return all;
+}
+
+// usage: rank_error [insert%,...] [backoff]
+//	insert%:	% of the ops of a unit that are inserts, the others are
+//			delete-mins (default: 50)
+//	backoff:	log2 of the max backoff (us) of a unit that finds a heap
+//			locked (default: log2 of bk_max)
+// every unit first inserts its share of TOTAL_OPS / 2 random keys into the
+// MultiQueue, then runs its share of TOTAL_OPS ops, and finally drains it. The
+// rank errors of the delete-mins are measured against a sequential reference
+// (units of one compute node only, as the history is ordered by their clocks)
+// e.g. rank_error 50,70 6 runs the bench with 50% and 70% inserts, backing off
+// for 64 us at most
+int main(int argc, char *argv[])
+{
+	uint64_t	key,
+			value,
+			num_ops,
+			num_init,
+			empty,
+			fresh,
+			repeated,
+			lost;
+	double		elapsed_time,
+			total_time;
+	bclx::timer	tim;
+	bclx::histogram	rank_err;
+
+	BCL::init();
+
+	bclx::topology	topo;
+
+	std::vector<uint64_t>	percents = bclx::split_num(argc > 1 ? argv[1] : "50");
+	std::mt19937_64		gen(BCL::rank());
+
+	if (argc > 2)
+		bk_max = exp2l(std::stoull(argv[2]));
+
+	num_ops = TOTAL_OPS / BCL::nprocs();
+	num_init = TOTAL_OPS / 2 / BCL::nprocs();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		printf("*********************************************************\n");
+		printf("*\tBENCHMARK\t:\tRank error\t\t*\n");
+		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+		printf("*\tNUM_OPS\t\t:\t%lu (ops/unit)\t\t*\n", num_ops);
+		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+		printf("*\tBK_MAX\t\t:\t%lu (us)\t\t\t*\n", bk_max);
+		printf("*********************************************************\n");
+		printf("insert%%, deletes, empty, rank error mean, p50, p99, p999, max, "
+				"fresh, repeated, lost, throughput (ops/s)\n");
+	}
+
+	for (const uint64_t &percent : percents)
+	{
+		if (percent > 100)
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: The insert%% must be in [0, 100]!\n");
+			continue;
+		}
+
+		// a heap holds the initial keys and every insert of its unit
+		mq::pqueue<uint64_t>		myPQueue(num_init + num_ops);
+		std::vector<record>		hist;
+		std::bernoulli_distribution	coin(percent / 100.0);
+		uint64_t			seq = 0;
+
+		// values are unique: the rank of the unit in the upper half, the #
+		// inserts of the unit in the lower; keys leave out the empty key
+		auto insert = [&]()
+		{
+			key = gen() >> 1;
+			value = (BCL::rank() << 32) | seq++;
+			bool status = myPQueue.insert(key, value);
+			hist.push_back({key, value, bclx::now(), INS, status});
+		};
+		auto delete_min = [&]()
+		{
+			bool status = myPQueue.delete_min(key, value);
+			hist.push_back({key, value, bclx::now(), DEL, status});
+			return status;
+		};
+
+		for (uint64_t i = 0; i < num_init; ++i)
+			insert();
+		empty = 0;
+
+		// synchronize
+		bclx::barrier_sync();
+
+		tim.reset();
+		tim.start();	// start the timer
+
+		for (uint64_t i = 0; i < num_ops; ++i)
+		{
+			if (coin(gen))
+				insert();
+			else if (!delete_min())
+				++empty;
+
+			bclx::think(uint64_t(WORKLOAD) * 1000);
+		}
+
+		tim.stop();	// stop the timer
+
+		elapsed_time = tim.get() - ((double) num_ops * WORKLOAD) / 1000000;
+
+		// synchronize
+		bclx::barrier_sync();
+
+		// drain the queue, so that the history is complete
+		while (delete_min());
+
+		total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+		empty = bclx::reduce(empty, MASTER_UNIT, BCL::sum<uint64_t>{});
+		std::vector<record> all = gather(hist);
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			if (topo.node_num > 1)
+				printf("%lu, -, %lu, -, -, -, -, -, -, -, -, %f\n",
+						percent, empty, TOTAL_OPS / total_time);
+			else
+			{
+				rank_err.reset();
+				replay(all, rank_err, fresh, repeated, lost);
+				printf("%lu, %lu, %lu, %.2f, %lu, %lu, %lu, %lu, %lu, %lu, %lu, %f\n",
+						percent, rank_err.count(), empty,
+						rank_err.mean(), rank_err.percentile(50),
+						rank_err.percentile(99), rank_err.percentile(99.9),
+						rank_err.max(), fresh, repeated, lost,
+						TOTAL_OPS / total_time);
+			}
+		}
+	}
+
+	BCL::finalize();
+
+	return 0;
+}
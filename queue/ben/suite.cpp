@@ -0,0 +1,318 @@
+#include <cstdint>			// uint32_t...
+#include <string>			// std::string...
+#include <vector>			// std::vector...
+#include <unordered_map>		// std::unordered_map...
+#include <bclx/bclx.hpp>		// BCL::init...
+#include "../inc/queue_factory.h"	// dds::make_queue...
+
+using namespace dds;
+
+/* Datatypes */
+// an op of the history checked for linearizability
+struct record
+{
+	uint64_t	value;	// be the enqueued or dequeued value
+	uint64_t	start;	// be the invocation time (ns)
+	uint64_t	end;	// be the response time (ns)
+	uint32_t	op;	// be 0 for an enqueue, 1 for a dequeue
+	uint32_t	status;	// be the result of the op
+};
+
+const uint32_t	ENQ	= 0;
+const uint32_t	DEQ	= 1;
+const uint64_t	BURST	= 64;	// be # ops of a unit in a row of the same kind (bursty)
+
+// get the kind of the i-th op of the calling unit
+uint32_t op_of(const std::string &pattern, const uint64_t &i)
+{
+	if (pattern == "pc")
+		return (BCL::rank() % 2 == 0) ? ENQ : DEQ;
+	if (pattern == "pairs")
+		return (i % 2 == 0) ? ENQ : DEQ;
+	if (pattern == "scatter")
+		return (BCL::rank() == MASTER_UNIT) ? ENQ : DEQ;
+	// if (pattern == "bursty"): odd units are half a phase behind even ones
+	return ((i / BURST + BCL::rank()) % 2 == 0) ? ENQ : DEQ;
+}
+
+// check that a complete history (every value left is drained) is a linearizable
+// FIFO history [Henzinger et al., CONCUR'13]: no value is dequeued that was not
+// enqueued (fresh) or more than once (repeated), no two values are dequeued in
+// the reverse of the real-time order of their enqueues (ordered), and no dequeue
+// finds the queue empty while a value is surely in it (witness). A relaxed
+// queue, which hands out values out of FIFO order, is checked for the first two
+// only, i.e. that every value enqueued is dequeued exactly once
+void check(const std::vector<record> &hist, const bool &fifo)
+{
+	std::unordered_map<uint64_t, uint64_t>	enqs,
+						deqs;
+	std::vector<uint64_t>			enq_list,
+						empty_list;
+	uint64_t				fresh = 0,
+						repeated = 0,
+						ordered = 0,
+						witness = 0,
+						lost = 0;
+
+	for (uint64_t i = 0; i < hist.size(); ++i)
+		if (hist[i].op == ENQ && hist[i].status)
+		{
+			enqs[hist[i].value] = i;
+			enq_list.push_back(i);
+		}
+		else if (hist[i].op == DEQ && hist[i].status)
+		{
+			if (deqs.count(hist[i].value) != 0)
+				++repeated;
+			else
+				deqs[hist[i].value] = i;
+		}
+		else if (hist[i].op == DEQ)
+			empty_list.push_back(i);
+
+	for (const auto &d : deqs)
+	{
+		auto e = enqs.find(d.first);
+		if (e == enqs.end() || hist[d.second].end < hist[e->second].start)
+			++fresh;
+	}
+
+	for (uint64_t a : enq_list)
+	{
+		auto da = deqs.find(hist[a].value);
+		if (da == deqs.end())
+			++lost;
+		if (!fifo)
+			continue;
+
+		// a value enqueued after A is dequeued, but A is not, or only later
+		for (uint64_t b : enq_list)
+		{
+			if (hist[a].end >= hist[b].start)
+				continue;
+			auto db = deqs.find(hist[b].value);
+			if (db != deqs.end() && (da == deqs.end() ||
+					hist[db->second].end < hist[da->second].start))
+				++ordered;
+		}
+
+		// A is in the queue for the whole of an empty dequeue
+		for (uint64_t d : empty_list)
+			if (hist[a].end < hist[d].start && (da == deqs.end() ||
+					hist[da->second].start > hist[d].end))
+				++witness;
+	}
+
+	if (fifo)
+		printf("check, %lu ops, fresh %lu, repeated %lu, ordered %lu, witness %lu, lost %lu: %s\n",
+				hist.size(), fresh, repeated, ordered, witness, lost,
+				(fresh + repeated + ordered + witness + lost == 0) ? "PASSED" : "FAILED");
+	else
+		printf("check, %lu ops, fresh %lu, repeated %lu, lost %lu: %s\n",
+				hist.size(), fresh, repeated, lost,
+				(fresh + repeated + lost == 0) ? "PASSED" : "FAILED");
+}
+
+// gather the histories of every unit to MASTER_UNIT
+std::vector<record> gather(const std::vector<record> &hist)
+{
+	std::vector<record>	all;
+	std::vector<int>	counts(BCL::nprocs()),
+				displs(BCL::nprocs());
+	int			count = hist.size() * sizeof(record),
+				total = 0;
+
+	MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MASTER_UNIT, BCL::comm);
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		displs[i] = total;
+		total += counts[i];
+	}
+	if (BCL::rank() == MASTER_UNIT)
+		all.resize(total / sizeof(record));
+	MPI_Gatherv(hist.data(), count, MPI_BYTE, all.data(), counts.data(), displs.data(),
+			MPI_BYTE, MASTER_UNIT, BCL::comm);
+	return all;
+}
+
+// usage: suite [pattern,...] [queue,...] [memory,...] [check]
+//	pattern:	pc (even units enqueue, odd units dequeue), pairs (every unit
+//			alternates enqueues and dequeues), bursty (every unit alternates
+//			BURST enqueues and BURST dequeues) or scatter (MASTER_UNIT
+//			enqueues, the other units dequeue)
+//	check:		# ops per unit of a small run whose history is checked to be
+//			a linearizable FIFO history (units of one compute node only),
+//			or for spmc that every value is dequeued exactly once, 0 for a
+//			timed run of TOTAL_OPS ops (default)
+// e.g. suite pc,pairs,bursty msq,tlq hp,nbr runs every pattern with every
+// queue and every memory manager, suite pc scq,lscq runs the queues that take no
+// memory manager, suite pairs msq hp 256 checks the MS queue, and suite scatter
+// spmc "" 256 checks the SPMC ring, which takes the scatter pattern only
+int main(int argc, char *argv[])
+{
+	uint64_t	value,
+			num_ops,
+			start,
+			empty;
+	double		elapsed_time,
+			total_time;
+	bclx::timer	tim;
+	bclx::histogram	lat_enq,
+			lat_deq;
+
+	BCL::init();
+
+	bclx::topology	topo;
+
+	std::vector<std::string>	patterns = bclx::split(argc > 1 ? argv[1] : "pc"),
+					variants = bclx::split(argc > 2 ? argv[2] : "msq"),
+					mem_names = bclx::split(argc > 3 ? argv[3] : "");
+	uint64_t			check_ops = (argc > 4) ? std::stoull(argv[4]) : 0;
+
+	if (check_ops > 0 && topo.node_num > 1)
+	{
+		if (BCL::rank() == MASTER_UNIT)
+			printf("ERROR: The check needs the clocks of one compute node!\n");
+		BCL::finalize();
+		return -1;
+	}
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		printf("*********************************************************\n");
+		printf("*\tBENCHMARK\t:\tQueue suite\t\t*\n");
+		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+		printf("*\tNUM_OPS\t\t:\t%lu (ops)\t\t*\n", (check_ops > 0) ? check_ops * BCL::nprocs() : TOTAL_OPS);
+		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+		printf("*********************************************************\n");
+		printf("pattern, queue, memory, op, count, "
+				"mean (ns), p50 (ns), p99 (ns), p999 (ns), max (ns), throughput (ops/s)\n");
+	}
+
+	for (const std::string &pattern : patterns)
+	for (const std::string &variant : variants)
+	for (const std::string &mem_name : mem_names)
+	{
+		if (pattern != "pc" && pattern != "pairs" && pattern != "bursty" && pattern != "scatter")
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: unknown pattern %s\n", pattern.c_str());
+			continue;
+		}
+		if (pattern == "pc" && BCL::nprocs() % 2 != 0)
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: The number of units must be even!\n");
+			continue;
+		}
+		if (pattern == "scatter" && BCL::nprocs() < 2)
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: The number of units must be at least 2!\n");
+			continue;
+		}
+		if (variant == "spmc" && pattern != "scatter")
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: spmc has a single producer, so it takes the scatter pattern only\n");
+			continue;
+		}
+
+		// a timed run starts with elems for the dequeues to find, a checked
+		// run with none, so that its history holds every enqueue
+		queue_name = mem_manager = "";
+		std::unique_ptr<queue<uint64_t>> myQueue = make_queue<uint64_t>(variant, mem_name,
+				(check_ops > 0) ? 0 : TOTAL_OPS / 2);
+		if (myQueue == nullptr)
+			continue;
+		num_ops = (check_ops > 0) ? check_ops : TOTAL_OPS / BCL::nprocs();
+
+		std::vector<record>	hist;
+		lat_enq.reset();
+		lat_deq.reset();
+		empty = 0;
+
+		// synchronize
+		bclx::barrier_sync();
+
+		tim.reset();
+		tim.start();	// start the timer
+
+		for (uint64_t i = 0; i < num_ops; ++i)
+		{
+			bool status;
+
+			start = bclx::now();
+			if (op_of(pattern, i) == ENQ)
+			{
+				// values are unique: the rank of the unit (+ 1, as the initial
+				// values are small) in the upper half, the op index in the lower
+				value = ((BCL::rank() + 1) << 32) | i;
+				status = myQueue->enqueue(value);
+				lat_enq.record(bclx::now() - start);
+				if (check_ops > 0)
+					hist.push_back({value, start, bclx::now(), ENQ, status});
+			}
+			else
+			{
+				status = myQueue->dequeue(value);
+				lat_deq.record(bclx::now() - start);
+				if (!status)
+					++empty;
+				if (check_ops > 0)
+					hist.push_back({value, start, bclx::now(), DEQ, status});
+			}
+
+			bclx::think(uint64_t(WORKLOAD) * 1000);
+		}
+		myQueue->flush();
+
+		tim.stop();	// stop the timer
+
+		elapsed_time = tim.get() - ((double) num_ops * WORKLOAD) / 1000000;
+
+		total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+		empty = bclx::reduce(empty, MASTER_UNIT, BCL::sum<uint64_t>{});
+		bclx::histogram	total_enq = lat_enq.reduce(BCL::comm, MASTER_UNIT),
+				total_deq = lat_deq.reduce(BCL::comm, MASTER_UNIT);
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			const bclx::histogram	*hists[] = {&total_enq, &total_deq};
+			const char		*ops[] = {"enqueue", "dequeue"};
+
+			for (uint32_t j = 0; j < 2; ++j)
+				printf("%s, %s, %s, %s, %lu, %.0f, %lu, %lu, %lu, %lu, %f\n",
+						pattern.c_str(), queue_name.c_str(), mem_manager.c_str(),
+						ops[j], hists[j]->count(), hists[j]->mean(),
+						hists[j]->percentile(50), hists[j]->percentile(99),
+						hists[j]->percentile(99.9), hists[j]->max(),
+						(num_ops * BCL::nprocs()) / total_time);
+			if (empty > 0)
+				printf("[%lu]WARNING: %lu dequeues found the queue empty\n", BCL::rank(), empty);
+		}
+
+		if (check_ops > 0)
+		{
+			// synchronize
+			bclx::barrier_sync();
+
+			// drain the queue, so that the history is complete
+			do {
+				start = bclx::now();
+				bool status = myQueue->dequeue(value);
+				hist.push_back({value, start, bclx::now(), DEQ, status});
+			} while (hist.back().status);
+
+			std::vector<record> all = gather(hist);
+			if (BCL::rank() == MASTER_UNIT)
+				check(all, variant != "spmc");
+		}
+
+		// destroy the queue before creating the next one
+		myQueue.reset();
+	}
+
+	BCL::finalize();
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include <cstdint>		// uint32_t...
+#include <string>		// std::string...
+#include <vector>		// std::vector...
+#include <bclx/bclx.hpp>	// BCL::init...
+#include "../inc/queue.h"	// dds::wsd...
+
+using namespace dds;
+
+// usage: work_stealing [depth,...]
+//	depth:	# tasks MASTER_UNIT keeps in its deque at most, before it runs one
+//		itself (default: 1, 16, 256)
+// MASTER_UNIT spawns TOTAL_OPS tasks into its deque and pops them, while the
+// other units steal from random victims. A task runs for WORKLOAD us. A depth
+// of 1 makes every pop of the owner race the thieves for the last task. Every
+// task is checked to be run exactly once
+// e.g. work_stealing 1,4 runs the bench with a depth of 1 and of 4
+int main(int argc, char *argv[])
+{
+	uint64_t	value,
+			spawned,
+			stolen,
+			no_steal,
+			no_pop;
+	double		elapsed_time,
+			total_time;
+	bclx::timer	tim;
+
+	BCL::init();
+
+	std::vector<uint64_t>	depths = bclx::split_num(argc > 1 ? argv[1] : "1,16,256");
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		printf("*********************************************************\n");
+		printf("*\tBENCHMARK\t:\tWork-stealing\t\t*\n");
+		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+		printf("*\tNUM_TASKS\t:\t%lu (tasks)\t\t*\n", TOTAL_OPS);
+		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+		printf("*********************************************************\n");
+		printf("depth, executed, missing, repeated, stolen, failed steals, failed pops, "
+				"exec time (s), throughput (tasks/s), check\n");
+	}
+
+	for (const uint64_t &depth : depths)
+	{
+		if (depth == 0 || depth > TOTAL_OPS)
+		{
+			if (BCL::rank() == MASTER_UNIT)
+				printf("ERROR: The depth must be in [1, %lu]!\n", TOTAL_OPS);
+			continue;
+		}
+
+		wsd::deque<uint64_t>	myDeque;
+		std::vector<uint32_t>	runs(TOTAL_OPS, 0),	// be # times each task ran on this unit
+					total_runs(TOTAL_OPS, 0);
+		uint64_t		executed = 0,
+					missing = 0,
+					repeated = 0;
+
+		// MASTER_UNIT raises done once its deque is empty for good, as no other
+		// unit spawns tasks
+		bclx::gptr<uint64_t> done = BCL::alloc<uint64_t>(1);
+		bclx::store(uint64_t(0), done);
+		done.rank = MASTER_UNIT;
+		spawned = stolen = no_steal = no_pop = 0;
+
+		// synchronize
+		bclx::barrier_sync();
+
+		tim.reset();
+		tim.start();	// start the timer
+
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			while (true)
+			{
+				// spawn tasks until the deque holds depth of them
+				while (spawned < TOTAL_OPS && myDeque.size() < depth)
+					if (myDeque.push(spawned))
+						++spawned;
+					else // if the deque is full
+						break;
+
+				// run the newest task, unless a thief took it first
+				if (myDeque.pop(value))
+				{
+					++runs[value];
+					bclx::think(uint64_t(WORKLOAD) * 1000);
+				}
+				else if (spawned == TOTAL_OPS)
+					break;	// no task is left
+				else
+					++no_pop;
+			}
+			bclx::aput_sync(uint64_t(1), done);	// local
+		}
+		else // if (BCL::rank() != MASTER_UNIT)
+			while (true)
+			{
+				if (myDeque.steal(value))
+				{
+					++stolen;
+					++runs[value];
+					bclx::think(uint64_t(WORKLOAD) * 1000);
+				}
+				else if (bclx::aget_sync(done) == 1)	// remote
+					break;
+				else
+					++no_steal;
+			}
+
+		tim.stop();	// stop the timer
+
+		elapsed_time = tim.get();
+
+		// count the runs of every task over all units
+		MPI_Reduce(runs.data(), total_runs.data(), TOTAL_OPS, MPI_UINT32_T, MPI_SUM, MASTER_UNIT, BCL::comm);
+		total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+		stolen = bclx::reduce(stolen, MASTER_UNIT, BCL::sum<uint64_t>{});
+		no_steal = bclx::reduce(no_steal, MASTER_UNIT, BCL::sum<uint64_t>{});
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			for (uint64_t i = 0; i < TOTAL_OPS; ++i)
+			{
+				executed += total_runs[i];
+				if (total_runs[i] == 0)
+					++missing;
+				else if (total_runs[i] > 1)
+					++repeated;
+			}
+			printf("%lu, %lu, %lu, %lu, %lu, %lu, %lu, %f, %f, %s\n",
+					depth, executed, missing, repeated,
+					stolen, no_steal, no_pop,
+					total_time, TOTAL_OPS / total_time,
+					(missing + repeated == 0) ? "PASSED" : "FAILED");
+		}
+
+		// synchronize
+		bclx::barrier_sync();
+
+		done.rank = BCL::rank();
+		BCL::dealloc<uint64_t>(done);
+	}
+
+	BCL::finalize();
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+#ifndef DEQUE_WS_H
+#define DEQUE_WS_H
+
+#include <cstdint>	// uint64_t...
+
+namespace dds
+{
+
+namespace wsd
+{
+
+/* Macros */
+using namespace bclx;
+
+// a bounded work-stealing deque per unit [Chase & Lev, SPAA'05]. The owner
+// pushes and pops at the bottom of its own deque without any communication,
+// as it only touches its own window; thieves steal at the top of the deque of
+// a victim with one remote CAS, which the owner only joins for the last value
+template<typename T>
+class deque
+{
+public:
+	deque();					// collective
+	deque(const uint64_t &cap);			// collective
+	~deque();					// collective
+	bool push(const T &value);			// non-collective (owner)
+	bool pop(T &value);				// non-collective (owner)
+	bool steal(T &value);				// non-collective (thief)
+	bool steal(const uint64_t &rank, T &value);	// non-collective (thief)
+	uint64_t size() const;				// non-collective (owner)
+	void print();					// collective
+
+private:
+	uint64_t	capacity;	// be the # values a deque can hold
+	gptr<uint64_t>	top;		// be the index of the oldest value
+	gptr<uint64_t>	bottom;		// be the index of the next value to push
+	gptr<T>		items;		// be the values of the deque
+	topology	topo;		// contain node information
+	victim		victims;	// pick the deques to steal from
+
+	void init(const uint64_t &cap);
+};
+
+} /* namespace wsd */
+
+} /* namespace dds */
+
+template<typename T>
+dds::wsd::deque<T>::deque() : victims(topo)
+{
+	init(TOTAL_OPS);
+}
+
+template<typename T>
+dds::wsd::deque<T>::deque(const uint64_t &cap) : victims(topo)
+{
+	init(cap);
+}
+
+template<typename T>
+dds::wsd::deque<T>::~deque()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	BCL::dealloc<T>(items);
+	BCL::dealloc<uint64_t>(bottom);
+	BCL::dealloc<uint64_t>(top);
+}
+
+template<typename T>
+bool dds::wsd::deque<T>::push(const T &value)
+{
+	uint64_t	b = bclx::load(bottom),		// local
+			t = bclx::aget_sync(top);	// local
+
+	// the deque is full
+	if (b - t >= capacity)
+		return false;
+
+	// update the value, then publish it to thieves
+	bclx::store(value, items + b % capacity);	// local
+	bclx::aput_sync(b + 1, bottom);			// local
+	return true;
+}
+
+template<typename T>
+bool dds::wsd::deque<T>::pop(T &value)
+{
+	uint64_t	b = bclx::load(bottom),	// local
+			t;
+
+	// the deque is empty
+	if (b == bclx::aget_sync(top))	// local
+		return false;
+
+	// reserve the bottom value before looking at top, so that a thief either
+	// sees the reservation or is seen by the owner
+	--b;
+	bclx::aput_sync(b, bottom);	// local
+	t = bclx::aget_sync(top);	// local
+	if (t < b)
+	{
+		// more than one value is left: no thief can reach the bottom one
+		value = bclx::load(items + b % capacity);	// local
+		return true;
+	}
+
+	// the last value goes to whoever moves top first
+	bool taken = (t == b) && bclx::cas_sync(top, t, t + 1) == t;	// local
+	if (taken)
+		value = bclx::load(items + b % capacity);	// local
+	bclx::aput_sync(b + 1, bottom);	// local
+
+	// tracing
+	#ifdef	TRACING
+		if (!taken)
+			++fail_cs;
+	#endif
+
+	return taken;
+}
+
+template<typename T>
+bool dds::wsd::deque<T>::steal(T &value)
+{
+	return steal(victims.next(), value);
+}
+
+template<typename T>
+bool dds::wsd::deque<T>::steal(const uint64_t &rank, T &value)
+{
+	gptr<uint64_t>	topAddr = {rank, top.ptr},
+			bottomAddr = {rank, bottom.ptr};
+	uint64_t	t,
+			b;
+
+	// get top before bottom, so that a concurrent pop of the owner is not missed
+	t = bclx::aget_sync(topAddr);		// one RMA
+	b = bclx::aget_sync(bottomAddr);	// one RMA
+	if (t >= b)
+		return false;	// the deque is empty now
+
+	// get the value before the CAS: the owner only overwrites its slot once
+	// top has moved past it, in which case the CAS below fails
+	value = bclx::rget_sync(gptr<T>{rank, (items + t % capacity).ptr});	// one RMA
+	if (bclx::cas_sync(topAddr, t, t + 1) == t)	// one RMA
+	{
+		// tracing
+		#ifdef	TRACING
+			++succ_cs;
+		#endif
+
+		return true;
+	}
+
+	// tracing
+	#ifdef	TRACING
+		++fail_cs;
+	#endif
+
+	return false;
+}
+
+template<typename T>
+uint64_t dds::wsd::deque<T>::size() const
+{
+	return bclx::load(bottom) - bclx::aget_sync(top);	// local
+}
+
+template<typename T>
+void dds::wsd::deque<T>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	for (uint64_t i = bclx::load(top); i < bclx::load(bottom); ++i)
+		printf("[%lu]value = %d\n", BCL::rank(), bclx::load(items + i % capacity));
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+void dds::wsd::deque<T>::init(const uint64_t &cap)
+{
+	capacity = cap;
+	top = BCL::alloc<uint64_t>(1);
+	bottom = BCL::alloc<uint64_t>(1);
+	items = BCL::alloc<T>(capacity);
+	if (items == nullptr)
+		printf("[%lu]ERROR: deque.deque\n", BCL::rank());
+	bclx::store(uint64_t(0), top);
+	bclx::store(uint64_t(0), bottom);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+#endif /* DEQUE_WS_H */
@@ -0,0 +1,289 @@
+#ifndef PQUEUE_MULTI_H
+#define PQUEUE_MULTI_H
+
+#include <random>	// std::mt19937...
+#include <cstdint>	// uint64_t...
+
+namespace dds
+{
+
+namespace mq
+{
+
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
+template<typename T>
+struct elem
+{
+	uint64_t	key;
+	T		value;
+};
+
+// a relaxed priority queue made of one binary heap per unit [Rihani et al.,
+// SPAA'15]. A unit inserts into its own heap, and deletes the min of the better
+// of two random heaps, whose min keys are published next to their locks. The
+// deleted key is not the global min, but close to it with high probability
+template<typename T>
+class pqueue
+{
+public:
+	pqueue();						// collective
+	pqueue(const uint64_t &cap);				// collective
+	~pqueue();						// collective
+	bool insert(const uint64_t &key, const T &value);	// non-collective
+	bool delete_min(uint64_t &key, T &value);		// non-collective
+	void print();						// collective
+
+private:
+	const uint64_t	UNLOCKED	= 0;
+	const uint64_t	LOCKED		= 1;
+	const uint64_t	EMPTY_KEY	= UINT64_MAX;	// be the min key of an empty heap
+
+	uint64_t		capacity;	// be the # elems a heap can hold
+	gptr<uint64_t>		lock;		// be the lock of the heap of each unit
+	gptr<uint64_t>		top;		// be the min key of the heap of each unit
+	gptr<uint64_t>		size;		// be the # elems in the heap of each unit
+	gptr<elem<T>>		heap;		// be the elems of the heap of each unit
+	std::mt19937_64		gen;
+
+	void init(const uint64_t &cap);
+	bool try_delete(const uint64_t &rank, uint64_t &key, T &value);
+	uint64_t sample(uint64_t &minKey);
+};
+
+} /* namespace mq */
+
+} /* namespace dds */
+
+template<typename T>
+dds::mq::pqueue<T>::pqueue()
+{
+	init(TOTAL_OPS);
+}
+
+template<typename T>
+dds::mq::pqueue<T>::pqueue(const uint64_t &cap)
+{
+	init(cap);
+}
+
+template<typename T>
+dds::mq::pqueue<T>::~pqueue()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	BCL::dealloc<elem<T>>(heap);
+	BCL::dealloc<uint64_t>(size);
+	BCL::dealloc<uint64_t>(top);
+	BCL::dealloc<uint64_t>(lock);
+}
+
+template<typename T>
+bool dds::mq::pqueue<T>::insert(const uint64_t &key, const T &value)
+{
+	backoff		bk(bk_init, bk_max);
+	uint64_t	n,
+			i;
+
+	// lock the heap of the calling unit, which deleters may hold for a while
+	while (bclx::cas_sync(lock, UNLOCKED, LOCKED) != UNLOCKED)	// local
+	{
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+	}
+
+	n = bclx::load(size);	// local
+	if (n == capacity)
+	{
+		bclx::aput_sync(UNLOCKED, lock);	// local
+		return false;
+	}
+
+	// sift the new elem up (local memory)
+	for (i = n; i > 0; i = (i - 1) / 2)
+	{
+		elem<T> parent = bclx::load(heap + (i - 1) / 2);
+		if (parent.key <= key)
+			break;
+		bclx::store(parent, heap + i);
+	}
+	bclx::store(elem<T>{key, value}, heap + i);
+	bclx::store(n + 1, size);
+
+	// publish the new min key, then unlock
+	if (i == 0)
+		bclx::aput_sync(key, top);		// local
+	bclx::aput_sync(UNLOCKED, lock);		// local
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+bool dds::mq::pqueue<T>::delete_min(uint64_t &key, T &value)
+{
+	backoff		bk(bk_init, bk_max);
+	uint64_t	rank,
+			minKey;
+
+	while (true)
+	{
+		rank = sample(minKey);
+
+		// every heap is empty
+		if (minKey == EMPTY_KEY)
+			return false;
+
+		if (try_delete(rank, key, value))
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			return true;
+		}
+
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+	}
+}
+
+template<typename T>
+void dds::mq::pqueue<T>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	for (uint64_t i = 0; i < bclx::load(size); ++i)
+		printf("[%lu]key = %lu\n", BCL::rank(), bclx::load(heap + i).key);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+void dds::mq::pqueue<T>::init(const uint64_t &cap)
+{
+	capacity = cap;
+	gen.seed(BCL::rank());
+
+	// every unit allocates its heap in the same order, so that the heap of
+	// another unit is found at the same offsets in its window
+	lock = BCL::alloc<uint64_t>(1);
+	top = BCL::alloc<uint64_t>(1);
+	size = BCL::alloc<uint64_t>(1);
+	heap = BCL::alloc<elem<T>>(capacity);
+	if (heap == nullptr)
+		printf("[%lu]ERROR: pqueue.pqueue\n", BCL::rank());
+	bclx::store(UNLOCKED, lock);
+	bclx::store(EMPTY_KEY, top);
+	bclx::store(uint64_t(0), size);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+bool dds::mq::pqueue<T>::try_delete(const uint64_t &rank, uint64_t &key, T &value)
+{
+	gptr<uint64_t>	lockAddr = {rank, lock.ptr},
+			sizeAddr = {rank, size.ptr};
+	gptr<elem<T>>	heapAddr = {rank, heap.ptr};
+	elem<T>		last,
+			child[2];
+	uint64_t	n,
+			i,
+			c,
+			newKey;
+
+	// another unit holds the heap
+	if (bclx::cas_sync(lockAddr, UNLOCKED, LOCKED) != UNLOCKED)	// one RMA
+		return false;
+
+	// the heap has been emptied since it was sampled
+	n = bclx::aget_sync(sizeAddr);	// one RMA
+	if (n == 0)
+	{
+		bclx::aput_sync(UNLOCKED, lockAddr);	// one RMA
+		return false;
+	}
+
+	// take the root, then sift the last elem down from it
+	child[0] = bclx::rget_sync(heapAddr);			// one RMA
+	key = child[0].key;
+	value = child[0].value;
+	last = bclx::rget_sync(heapAddr + (--n));		// one RMA
+	newKey = (n == 0) ? EMPTY_KEY : last.key;
+	for (i = 0; (c = 2 * i + 1) < n; i = c)
+	{
+		// get both children in one RMA
+		bclx::rget_sync(heapAddr + c, child, (c + 1 < n) ? 2 : 1);	// one RMA
+		if (c + 1 < n && child[1].key < child[0].key)
+		{
+			child[0] = child[1];
+			++c;
+		}
+		if (last.key <= child[0].key)
+			break;
+		bclx::rput_sync(child[0], heapAddr + i);	// one RMA
+		if (i == 0)
+			newKey = child[0].key;
+	}
+	if (n > 0)
+		bclx::rput_sync(last, heapAddr + i);	// one RMA
+
+	// publish the new size and min key, then unlock
+	bclx::aput_sync(n, sizeAddr);				// one RMA
+	bclx::aput_sync(newKey, gptr<uint64_t>{rank, top.ptr});	// one RMA
+	bclx::aput_sync(UNLOCKED, lockAddr);			// one RMA
+	return true;
+}
+
+template<typename T>
+uint64_t dds::mq::pqueue<T>::sample(uint64_t &minKey)
+{
+	std::uniform_int_distribution<uint64_t>	dist(0, BCL::nprocs() - 1);
+	uint64_t				rank = dist(gen),
+						other = dist(gen),
+						otherKey;
+
+	// compare the min keys of two random heaps
+	minKey = bclx::aget_sync(gptr<uint64_t>{rank, top.ptr});	// one RMA
+	if (other != rank)
+	{
+		otherKey = bclx::aget_sync(gptr<uint64_t>{other, top.ptr});	// one RMA
+		if (otherKey < minKey)
+		{
+			minKey = otherKey;
+			rank = other;
+		}
+	}
+
+	// both heaps are empty: look for any heap that is not
+	for (uint64_t i = 1; minKey == EMPTY_KEY && i < BCL::nprocs(); ++i)
+	{
+		other = (rank + i) % BCL::nprocs();
+		minKey = bclx::aget_sync(gptr<uint64_t>{other, top.ptr});	// one RMA
+		if (minKey != EMPTY_KEY)
+			rank = other;
+	}
+	return rank;
+}
+
+#endif /* PQUEUE_MULTI_H */
@@ -1,10 +1,28 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "../config.h"		// Configurations
+#include "../config.h"			// Configurations
+
+#include "../../memory/inc/memory.h"	// Global Memory Management
 
 // #include "queue_blocking.h"	// A Lock-Based Queue
 
-#include "queue_spsc.h"		// A Single-Producer/Single-Consumer Unbounded Queue
+#include "queue_spsc.h"		// A Single-Producer/Single-Consumer Bounded Queue
+
+#include "queue_spmc.h"		// A Single-Producer/Multi-Consumer Bounded Queue
+
+#include "queue_ms.h"		// Michael-Scott Queue
+
+#include "queue_2lock.h"	// Michael-Scott Two-Lock Queue with Cohort Locks [Michael & Scott, PODC'96]
+
+#include "queue_scq.h"		// A Bounded Ring Queue of Fetch-and-Add Tickets [Nikolaev, DISC'19]
+
+#include "queue_lscq.h"		// An Unbounded Queue of Linked Ring Segments [Nikolaev, DISC'19]
+
+#include "queue_nc.h"		// A Node-Local Combining Front End for a Global Queue
+
+#include "deque_ws.h"		// A Work-Stealing Deque per Unit [Chase & Lev, SPAA'05]
+
+#include "pqueue_multi.h"	// A Relaxed Priority Queue of Heaps per Unit (MultiQueue) [Rihani et al., SPAA'15]
 
 #endif /* QUEUE_H */
@@ -0,0 +1,227 @@
+#ifndef QUEUE_2LOCK_H
+#define QUEUE_2LOCK_H
+
+#include "../../lock/inc/lock_cohort.h"	// dds::cohl::lock...
+
+namespace dds
+{
+
+namespace tlq
+{
+
+/* Macros */
+#ifdef		MEM_HP
+	using namespace hp;
+#elif defined 	MEM_HE
+	using namespace he;
+#elif defined	MEM_IBR
+	using namespace ibr;
+#elif defined	MEM_DANG3
+	using namespace dang3;
+#elif defined	MEM_NBR
+	using namespace nbr;
+#elif defined	MEM_BL3
+	using namespace bl3;
+#else	// No Memory Reclamation
+	using namespace nmr;
+#endif
+
+/* Datatypes */
+template<typename T>
+struct elem
+{
+	gptr<elem<T>>	next;
+	T		value;
+};
+
+// the two-lock queue [Michael & Scott, PODC'96]: head and tail have a lock
+// each, and a dummy elem keeps enqueuers and dequeuers apart, so that one
+// enqueue and one dequeue proceed at the same time. Both locks are cohort
+// locks, which stay within a compute node for a batch of operations
+template<typename T, template<typename> class M = memory>
+class queue
+{
+public:
+	M<elem<T>>		mem;	// manage global memory
+
+	queue();			// collective
+	queue(const uint64_t &num);	// collective
+	~queue();			// collective
+	bool enqueue(const T &value);	// non-collective
+	bool dequeue(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	const gptr<elem<T>>	NULL_PTR = nullptr;	// be a null constant
+
+	cohl::lock		head_lock;	// serialize dequeuers
+	cohl::lock		tail_lock;	// serialize enqueuers
+	gptr<gptr<elem<T>>>	head;	// point to global address of the dummy elem (hosted by MASTER_UNIT)
+	gptr<gptr<elem<T>>>	tail;	// point to global address of the last elem (hosted by MASTER_UNIT)
+
+	void init(const uint64_t &num);
+	gptr<gptr<elem<T>>> next_of(const gptr<elem<T>> &addr) const;
+};
+
+} /* namespace tlq */
+
+} /* namespace dds */
+
+template<typename T, template<typename> class M>
+dds::tlq::queue<T, M>::queue()
+{
+	init(0);
+}
+
+template<typename T, template<typename> class M>
+dds::tlq::queue<T, M>::queue(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T, template<typename> class M>
+dds::tlq::queue<T, M>::~queue()
+{
+	if (BCL::rank() != MASTER_UNIT)
+		head.rank = tail.rank = BCL::rank();
+	BCL::dealloc<gptr<elem<T>>>(tail);
+	BCL::dealloc<gptr<elem<T>>>(head);
+}
+
+template<typename T, template<typename> class M>
+bool dds::tlq::queue<T, M>::enqueue(const T &value)
+{
+	gptr<elem<T>>	oldTailAddr,
+			newTailAddr;
+
+	// allocate global memory to the new elem
+	newTailAddr = mem.malloc();
+	if (newTailAddr == nullptr)
+		return false;
+
+	// update new element (global memory)
+	if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+		bclx::store({NULL_PTR, value}, newTailAddr);
+	else
+		bclx::rput_sync({NULL_PTR, value}, newTailAddr);
+
+	tail_lock.acquire();
+
+	// link the new elem after the last elem, then move tail to it
+	oldTailAddr = bclx::aget_sync(tail);			// one RMA
+	bclx::aput_sync(newTailAddr, next_of(oldTailAddr));	// one RMA
+	bclx::aput_sync(newTailAddr, tail);			// one RMA
+
+	tail_lock.release();
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T, template<typename> class M>
+bool dds::tlq::queue<T, M>::dequeue(T &value)
+{
+	gptr<elem<T>>	oldHeadAddr;
+	elem<T>		oldHeadNextVal;
+
+	head_lock.acquire();
+
+	// get head and its successor: the next field may be set by an enqueuer
+	// holding only the tail lock, hence the atomic get
+	oldHeadAddr = bclx::aget_sync(head);					// one RMA
+	oldHeadNextVal.next = bclx::aget_sync(next_of(oldHeadAddr));	// one RMA
+	if (oldHeadNextVal.next == nullptr)
+	{
+		head_lock.release();
+		return false;	// the queue is empty now
+	}
+
+	// the successor becomes the new dummy elem
+	value = bclx::rget_sync(oldHeadNextVal.next).value;		// one RMA
+	bclx::aput_sync(oldHeadNextVal.next, head);			// one RMA
+
+	head_lock.release();
+
+	// no other unit can reach the old dummy elem: head has moved past it, and
+	// tail has too, since its successor was linked before
+	mem.free(oldHeadAddr);
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T, template<typename> class M>
+void dds::tlq::queue<T, M>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		gptr<elem<T>>	headAddr;
+		elem<T>		headVal;
+
+		headVal = bclx::rget_sync(bclx::load(head));
+		for (headAddr = headVal.next; headAddr != nullptr; headAddr = headVal.next)
+		{
+			headVal = bclx::rget_sync(headAddr);
+			printf("value = %d\n", headVal.value);
+			headVal.next.print();
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+void dds::tlq::queue<T, M>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	head = BCL::alloc<gptr<elem<T>>>(1);
+	tail = BCL::alloc<gptr<elem<T>>>(1);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		// the queue starts with a dummy elem
+		gptr<elem<T>> dummy = mem.malloc();
+		if (dummy == nullptr)
+		{
+			printf("[%lu]ERROR: queue.queue\n", BCL::rank());
+			return;
+		}
+		bclx::store({NULL_PTR, T()}, dummy);
+		bclx::store(dummy, head);
+		bclx::store(dummy, tail);
+		queue_name = "TLQ";
+	}
+	else
+		head.rank = tail.rank = MASTER_UNIT;
+
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+		for (uint64_t i = 0; i < num; ++i)
+			enqueue(i);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+bclx::gptr<bclx::gptr<dds::tlq::elem<T>>> dds::tlq::queue<T, M>::next_of(const gptr<elem<T>> &addr) const
+{
+	return {addr.rank, addr.ptr};
+}
+
+#endif /* QUEUE_2LOCK_H */
@@ -0,0 +1,206 @@
+#ifndef QUEUE_FACTORY_H
+#define QUEUE_FACTORY_H
+
+#include <string>		// std::string...
+#include <memory>		// std::unique_ptr...
+#include <utility>		// std::forward...
+#include <vector>		// std::vector...
+#include "queue.h"		// Configurations, Global Memory Management & Queues
+
+namespace dds
+{
+
+/* Datatypes */
+// the interface every FIFO queue variant provides: a collective constructor
+// that takes # initial elems and non-collective enqueue/dequeue (the ring
+// queues have no print)
+template<typename T>
+class queue
+{
+public:
+	virtual ~queue() {}				// collective
+	virtual bool enqueue(const T &value) = 0;	// non-collective
+	virtual bool dequeue(T &value) = 0;		// non-collective
+	virtual void flush() {}				// non-collective: publish the enqueues issued so far
+};
+
+template<typename T, typename Q>
+class queue_adapter : public queue<T>
+{
+public:
+	template<typename... Args>
+	queue_adapter(Args&&... args);			// collective
+	bool enqueue(const T &value) override;		// non-collective
+	bool dequeue(T &value) override;		// non-collective
+
+private:
+	Q	q;	// be the wrapped queue variant
+};
+
+// the SPMC ring as a queue of single values: MASTER_UNIT is its only producer,
+// and every other unit a consumer, which keeps the rest of a claimed range
+// for its next dequeues
+template<typename T>
+class spmc_adapter : public queue<T>
+{
+public:
+	spmc_adapter(const uint64_t &cap, const uint64_t &num);	// collective
+	~spmc_adapter();					// collective
+	bool enqueue(const T &value) override;			// non-collective
+	bool dequeue(T &value) override;			// non-collective
+	void flush() override;					// non-collective
+
+private:
+	queue_spmc<T>	q;	// be the ring (hosted by MASTER_UNIT)
+	std::vector<T>	vals;	// be the values dequeued but not returned yet (consumer)
+	uint64_t	next;	// be the next value of vals to return (consumer)
+};
+
+/* Functions */
+template<typename T>
+std::unique_ptr<queue<T>> make_queue(const std::string &variant,	// collective: create a queue variant
+		const std::string &mem_name,				// using a memory manager ("" for the default one, or for scq, lscq and spmc)
+		const uint64_t &num);					// with # initial elems
+
+template<typename T, template<typename> class M>
+std::unique_ptr<queue<T>> make_queue_with(const std::string &variant,
+		const uint64_t &num);
+
+} /* namespace dds */
+
+template<typename T, typename Q>
+template<typename... Args>
+dds::queue_adapter<T, Q>::queue_adapter(Args&&... args) : q(std::forward<Args>(args)...) {}
+
+template<typename T, typename Q>
+bool dds::queue_adapter<T, Q>::enqueue(const T &value)
+{
+	return q.enqueue(value);
+}
+
+template<typename T, typename Q>
+bool dds::queue_adapter<T, Q>::dequeue(T &value)
+{
+	return q.dequeue(value);
+}
+
+template<typename T>
+dds::spmc_adapter<T>::spmc_adapter(const uint64_t &cap, const uint64_t &num) : q(MASTER_UNIT, cap), next{0}
+{
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		queue_name = "SPMC";
+		std::vector<T> init(num);
+		for (uint64_t i = 0; i < num; ++i)
+			init[i] = i;
+		if (num > 0)
+			q.enqueue(init);
+		q.flush();
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+dds::spmc_adapter<T>::~spmc_adapter()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	q.clear();
+}
+
+template<typename T>
+bool dds::spmc_adapter<T>::enqueue(const T &value)
+{
+	// only MASTER_UNIT produces
+	if (BCL::rank() != MASTER_UNIT)
+		return false;
+	return q.enqueue(&value, 1);
+}
+
+template<typename T>
+bool dds::spmc_adapter<T>::dequeue(T &value)
+{
+	// MASTER_UNIT consumes nothing, as the ring keeps its producer and
+	// consumer views in the same fields
+	if (BCL::rank() == MASTER_UNIT)
+		return false;
+
+	// take the next value of the last range, or get more of the ring
+	if (next == vals.size())
+	{
+		vals.clear();
+		next = 0;
+		if (!q.dequeue(vals))
+			return false;
+	}
+	value = vals[next++];
+	return true;
+}
+
+template<typename T>
+void dds::spmc_adapter<T>::flush()
+{
+	// the last tail is published lazily, by the next enqueue or by this flush
+	if (BCL::rank() == MASTER_UNIT)
+		q.flush();
+}
+
+template<typename T>
+std::unique_ptr<dds::queue<T>> dds::make_queue(const std::string &variant, const std::string &mem_name, const uint64_t &num)
+{
+	// the queues that manage no global memory of their own take no memory manager,
+	// and the bounded rings of scq and spmc hold every value a run may leave
+	// behind, plus the initial ones
+	if (variant == "scq" || variant == "lscq" || variant == "spmc")
+	{
+		if (mem_name != "")
+		{
+			printf("[%lu]ERROR: make_queue: %s takes no memory manager\n", BCL::rank(), variant.c_str());
+			return nullptr;
+		}
+		if (variant == "scq")
+			return std::unique_ptr<queue<T>>(new queue_adapter<T, scq::queue<T>>(TOTAL_OPS + num, num));
+		if (variant == "spmc")
+			return std::unique_ptr<queue<T>>(new spmc_adapter<T>(TOTAL_OPS + num, num));
+		return std::unique_ptr<queue<T>>(new queue_adapter<T, lscq::queue<T>>(num));
+	}
+
+	if (mem_name == "")
+		return make_queue_with<T, msq::memory>(variant, num);
+	if (mem_name == "nmr")
+		return make_queue_with<T, nmr::memory>(variant, num);
+	if (mem_name == "hp")
+		return make_queue_with<T, hp::memory>(variant, num);
+	if (mem_name == "he")
+		return make_queue_with<T, he::memory>(variant, num);
+	if (mem_name == "ibr")
+		return make_queue_with<T, ibr::memory>(variant, num);
+	if (mem_name == "nbr")
+		return make_queue_with<T, nbr::memory>(variant, num);
+	if (mem_name == "dang3")
+		return make_queue_with<T, dang3::memory>(variant, num);
+	if (mem_name == "bl3")
+		return make_queue_with<T, bl3::memory>(variant, num);
+
+	printf("[%lu]ERROR: make_queue: unknown memory manager %s\n", BCL::rank(), mem_name.c_str());
+	return nullptr;
+}
+
+template<typename T, template<typename> class M>
+std::unique_ptr<dds::queue<T>> dds::make_queue_with(const std::string &variant, const uint64_t &num)
+{
+	if (variant == "msq")
+		return std::unique_ptr<queue<T>>(new queue_adapter<T, msq::queue<T, M>>(num));
+	if (variant == "tlq")
+		return std::unique_ptr<queue<T>>(new queue_adapter<T, tlq::queue<T, M>>(num));
+	if (variant == "ncq")
+		return std::unique_ptr<queue<T>>(new queue_adapter<T, ncq::queue<T, msq::queue<T, M>>>(num));
+
+	printf("[%lu]ERROR: make_queue: unknown queue %s\n", BCL::rank(), variant.c_str());
+	return nullptr;
+}
+
+#endif /* QUEUE_FACTORY_H */
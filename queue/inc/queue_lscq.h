@@ -0,0 +1,370 @@
+#ifndef QUEUE_LSCQ_H
+#define QUEUE_LSCQ_H
+
+#include <vector>	// std::vector...
+#include <cstdint>	// uint64_t...
+#include <algorithm>	// std::sort...
+
+namespace dds
+{
+
+namespace lscq
+{
+
+using namespace bclx;
+
+// an unbounded queue of bounded SCQ segments linked from head to tail. An
+// enqueuer finding the tail segment full closes it and links a new segment
+// hosted by itself, so the segments spread over the units that enqueue.
+// Every unit publishes the segment it works on in a guard (a hazard pointer),
+// and the dequeuer that unlinks a drained segment marks it retired. The host
+// of a retired segment that no guard holds reuses it for its next new segment,
+// so a long run allocates only as many segments as are ever linked at once.
+//
+// Allocation order: a unit allocates its segments from the BCL window in the
+// middle of a run, so while an LSCQ is alive, the allocations of the units no
+// longer sit at the same offsets. A structure addressing the memory of other
+// units as {rank, mine.ptr} (scq, ncq, wsd, pqueue, shs, ebs3, tsp...) must be
+// constructed before the LSCQ or after it has been destroyed
+template<typename T>
+class queue
+{
+public:
+	queue();			// collective
+	queue(const uint64_t &num);	// collective
+	~queue();			// collective
+	bool enqueue(const T &value);	// non-collective
+	bool dequeue(T &value);		// non-collective
+
+private:
+	const gptr<uint64_t>	NULL_PTR	= nullptr;	// be a null constant
+	const uint64_t		LIVE		= 0;		// state of a linked or free segment
+	const uint64_t		RETIRED		= 1;		// state of an unlinked segment not reused yet
+
+	gptr<gptr<uint64_t>>		head;		// point to the first segment (hosted by MASTER_UNIT)
+	gptr<gptr<uint64_t>>		tail;		// point to the last segment (hosted by MASTER_UNIT)
+	gptr<gptr<uint64_t>>		guard;		// be the segment the calling unit works on
+	std::vector<gptr<uint64_t>>	segs;		// contain the segments allocated by the calling unit
+	std::vector<gptr<uint64_t>>	free_segs;	// contain the segments of the calling unit ready for reuse
+
+	void init(const uint64_t &num);
+	gptr<uint64_t> protect(const gptr<gptr<uint64_t>> &ptr);
+	gptr<uint64_t> seg_alloc();
+	void seg_collect();
+	bool seg_enqueue(const gptr<uint64_t> &seg, const T &value);
+	bool seg_dequeue(const gptr<uint64_t> &seg, T &value);
+	gptr<gptr<uint64_t>> next_of(const gptr<uint64_t> &seg) const;
+	gptr<uint64_t> state_of(const gptr<uint64_t> &seg) const;
+	scq::ring aq_of(const gptr<uint64_t> &seg) const;
+	scq::ring fq_of(const gptr<uint64_t> &seg) const;
+	gptr<T> items_of(const gptr<uint64_t> &seg) const;
+};
+
+} /* namespace lscq */
+
+} /* namespace dds */
+
+template<typename T>
+dds::lscq::queue<T>::queue()
+{
+	init(0);
+}
+
+template<typename T>
+dds::lscq::queue<T>::queue(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T>
+dds::lscq::queue<T>::~queue()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	for (uint64_t i = 0; i < segs.size(); ++i)
+		BCL::dealloc<uint64_t>(segs[i]);
+	if (BCL::rank() != MASTER_UNIT)
+		head.rank = tail.rank = BCL::rank();
+	BCL::dealloc<gptr<uint64_t>>(guard);
+	BCL::dealloc<gptr<uint64_t>>(tail);
+	BCL::dealloc<gptr<uint64_t>>(head);
+}
+
+template<typename T>
+bool dds::lscq::queue<T>::enqueue(const T &value)
+{
+	gptr<uint64_t>	oldTailAddr,
+			oldTailNext,
+			newTailAddr;
+
+	while (true)
+	{
+		// get tail and its successor (from global memory to local memory)
+		oldTailAddr = protect(tail);
+		oldTailNext = bclx::aget_sync(next_of(oldTailAddr));	// one RMA
+
+		// tail lags behind: swing it forward
+		if (oldTailNext != nullptr)
+		{
+			bclx::cas_sync(tail, oldTailAddr, oldTailNext);	// one RMA
+			continue;
+		}
+
+		// the common case: the tail segment has room
+		if (seg_enqueue(oldTailAddr, value))
+			return true;
+
+		// the tail segment is closed: link a new segment already holding the value
+		newTailAddr = seg_alloc();
+		if (newTailAddr == nullptr)
+			return false;
+		seg_enqueue(newTailAddr, value);	// local
+		if (bclx::cas_sync(next_of(oldTailAddr), NULL_PTR, newTailAddr) == NULL_PTR)	// one RMA
+		{
+			bclx::cas_sync(tail, oldTailAddr, newTailAddr);	// one RMA
+			return true;
+		}
+
+		// another unit has linked its segment first, and ours has never been visible
+		free_segs.push_back(newTailAddr);
+	}
+}
+
+template<typename T>
+bool dds::lscq::queue<T>::dequeue(T &value)
+{
+	gptr<uint64_t>	oldHeadAddr,
+			oldHeadNext;
+
+	while (true)
+	{
+		// get head (from global memory to local memory)
+		oldHeadAddr = protect(head);
+
+		// the common case: the head segment has a value
+		if (seg_dequeue(oldHeadAddr, value))
+			return true;
+
+		// the head segment is the last one, so the queue is empty
+		oldHeadNext = bclx::aget_sync(next_of(oldHeadAddr));	// one RMA
+		if (oldHeadNext == nullptr)
+			return false;
+
+		// the head segment is closed, but an enqueue may have completed in it after
+		// its ring was found empty: look once more before leaving it
+		aq_of(oldHeadAddr).reset();
+		if (seg_dequeue(oldHeadAddr, value))
+			return true;
+
+		// keep tail from lagging behind head, so that an unlinked segment is
+		// reachable from neither of them, then unlink the head segment
+		bclx::cas_sync(tail, oldHeadAddr, oldHeadNext);	// one RMA
+		if (bclx::cas_sync(head, oldHeadAddr, oldHeadNext) == oldHeadAddr)	// one RMA
+			bclx::aput_sync(RETIRED, state_of(oldHeadAddr));		// one RMA
+	}
+}
+
+template<typename T>
+void dds::lscq::queue<T>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	head = BCL::alloc<gptr<uint64_t>>(1);
+	tail = BCL::alloc<gptr<uint64_t>>(1);
+	guard = BCL::alloc<gptr<uint64_t>>(1);
+	bclx::store(NULL_PTR, guard);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		// the queue starts with an empty segment
+		gptr<uint64_t> seg = seg_alloc();
+		if (seg == nullptr)
+		{
+			printf("[%lu]ERROR: queue.queue\n", BCL::rank());
+			return;
+		}
+		bclx::store(seg, head);
+		bclx::store(seg, tail);
+		queue_name = "LSCQ";
+	}
+	else
+		head.rank = tail.rank = MASTER_UNIT;
+
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+		for (uint64_t i = 0; i < num; ++i)
+			enqueue(i);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+bclx::gptr<uint64_t> dds::lscq::queue<T>::protect(const gptr<gptr<uint64_t>> &ptr)
+{
+	gptr<uint64_t>	seg,
+			seg_new;
+
+	// publish the segment, then check that it is still linked
+	seg = bclx::aget_sync(ptr);	// one RMA
+	while (true)
+	{
+		bclx::aput_sync(seg, guard);	// local
+		seg_new = bclx::aget_sync(ptr);	// one RMA
+		if (seg_new == seg)
+			return seg;
+		seg = seg_new;
+	}
+}
+
+template<typename T>
+bclx::gptr<uint64_t> dds::lscq::queue<T>::seg_alloc()
+{
+	gptr<uint64_t>	seg;
+
+	// reuse a drained segment if there is one, otherwise allocate a new one
+	if (free_segs.empty())
+		seg_collect();
+	if (!free_segs.empty())
+	{
+		seg = free_segs.back();
+		free_segs.pop_back();
+	}
+	else // if (free_segs.empty())
+	{
+		// a segment is laid out in one block: next, state, aq, fq, items
+		seg = BCL::alloc<uint64_t>(2 + 2 * scq::ring::words(RING_SIZE) +
+				(RING_SIZE * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		if (seg == nullptr)
+			return seg;
+		segs.push_back(seg);
+	}
+	bclx::store(NULL_PTR, next_of(seg));	// local
+	bclx::store(LIVE, state_of(seg));	// local
+	aq_of(seg).init(false);			// local
+	fq_of(seg).init(true);			// local
+	return seg;
+}
+
+template<typename T>
+void dds::lscq::queue<T>::seg_collect()
+{
+	std::vector<gptr<uint64_t>>	retired,
+					guards(BCL::nprocs());
+	gptr<gptr<uint64_t>>		guard_temp = guard;
+
+	for (uint64_t i = 0; i < segs.size(); ++i)
+		if (bclx::aget_sync(state_of(segs[i])) == RETIRED)	// local
+			retired.push_back(segs[i]);
+	if (retired.empty())
+		return;
+
+	// get the guards of all units in one batch
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		guard_temp.rank = i;
+		bclx::aget_async(guard_temp, &guards[i], 1);
+	}
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		bclx::flush(i);
+	std::sort(guards.begin(), guards.end());
+
+	// a retired segment is reachable from neither head nor tail, so once no
+	// guard holds it, no unit can reach it any more
+	for (uint64_t i = 0; i < retired.size(); ++i)
+		if (!std::binary_search(guards.begin(), guards.end(), retired[i]))
+		{
+			bclx::aput_sync(LIVE, state_of(retired[i]));	// local
+			free_segs.push_back(retired[i]);
+		}
+}
+
+template<typename T>
+bool dds::lscq::queue<T>::seg_enqueue(const gptr<uint64_t> &seg, const T &value)
+{
+	uint64_t	index;
+
+	// take a free value, and close the segment if there is none
+	if (!fq_of(seg).dequeue(index))
+	{
+		aq_of(seg).finalize();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		return false;
+	}
+
+	// update the value, then publish its index unless the segment has been closed
+	bclx::rput_sync(value, items_of(seg) + index);	// one RMA
+	if (!aq_of(seg).enqueue(index))
+	{
+		fq_of(seg).enqueue(index);
+		return false;
+	}
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+bool dds::lscq::queue<T>::seg_dequeue(const gptr<uint64_t> &seg, T &value)
+{
+	uint64_t	index;
+
+	// take the index of the oldest value of the segment
+	if (!aq_of(seg).dequeue(index))
+		return false;
+
+	// get the value, then free it
+	value = bclx::rget_sync(items_of(seg) + index);	// one RMA
+	fq_of(seg).enqueue(index);
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+bclx::gptr<bclx::gptr<uint64_t>> dds::lscq::queue<T>::next_of(const gptr<uint64_t> &seg) const
+{
+	return {seg.rank, seg.ptr};
+}
+
+template<typename T>
+bclx::gptr<uint64_t> dds::lscq::queue<T>::state_of(const gptr<uint64_t> &seg) const
+{
+	return seg + 1;
+}
+
+template<typename T>
+dds::scq::ring dds::lscq::queue<T>::aq_of(const gptr<uint64_t> &seg) const
+{
+	return scq::ring(seg + 2, RING_SIZE);
+}
+
+template<typename T>
+dds::scq::ring dds::lscq::queue<T>::fq_of(const gptr<uint64_t> &seg) const
+{
+	return scq::ring(seg + 2 + scq::ring::words(RING_SIZE), RING_SIZE);
+}
+
+template<typename T>
+bclx::gptr<T> dds::lscq::queue<T>::items_of(const gptr<uint64_t> &seg) const
+{
+	return {seg.rank, (seg + 2 + 2 * scq::ring::words(RING_SIZE)).ptr};
+}
+
+#endif /* QUEUE_LSCQ_H */
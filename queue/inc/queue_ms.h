@@ -1,11 +1,8 @@
 #ifndef QUEUE_MS_H
 #define QUEUE_MS_H
 
-#ifdef MEM_REC
-        #include "../../memory/memory_hp.h"
-#else
-        #include "../../memory/memory_dang3.h"
-#endif
+#include <vector>			// std::vector...
+#include <bclx/core/util/backoff.hpp>	// backoff::backoff...
 
 namespace dds
 {
@@ -13,183 +10,521 @@ namespace dds
 namespace msq
 {
 
-        /* Macros */
-        #ifdef MEM_REC
-                using namespace hp;
-        #else
-                using namespace dang3;
-        #endif
+/* Macros */
+#ifdef		MEM_HP
+	using namespace hp;
+#elif defined 	MEM_HE
+	using namespace he;
+#elif defined	MEM_IBR
+	using namespace ibr;
+#elif defined	MEM_DANG3
+	using namespace dang3;
+#elif defined	MEM_NBR
+	using namespace nbr;
+#elif defined	MEM_BL3
+	using namespace bl3;
+#else	// No Memory Reclamation
+	using namespace nmr;
+#endif
 
-	/* Data types */
-	template <typename T>
-	struct elem
-	{
-		gptr<elem<T>>	next;
-		T		value;
-	};
+/* Datatypes */
+template<typename T>
+struct elem
+{
+	gptr<elem<T>>	next;
+	T		value;
+};
 
-	template <typename T>
-	class queue
-	{
-	public:
-		queue();			//collective
-		~queue();			//collective
-		bool enqueue(const T &);	//non-collective
-		bool dequeue(T &);		//non-collective
-		void print();			//collective
+template<typename T, template<typename> class M = memory>
+class queue
+{
+public:
+	M<elem<T>>		mem;	// manage global memory
+
+	queue();			// collective
+	queue(const uint64_t &num);	// collective
+	~queue();			// collective
+	bool enqueue(const T &value);	// non-collective
+	bool dequeue(T &value);		// non-collective
+	uint64_t enqueue(const T *values, const uint64_t &num);	// non-collective
+	uint64_t dequeue(T *values, const uint64_t &num);	// non-collective
+	void print();			// collective
+
+private:
+	const gptr<elem<T>>	NULL_PTR = nullptr;	// be a null constant
 
-	private:
-		const gptr<elem<T>>	NULL_PTR = nullptr;	//is a null constant
+	gptr<gptr<elem<T>>>	head;	// point to global address of the dummy elem (hosted by MASTER_UNIT)
+	gptr<gptr<elem<T>>>	tail;	// point to global address of the last elem (hosted by MASTER_UNIT)
 
-		memory<elem<T>>		mem;
-		gptr<gptr<elem<T>>>	front;
-		gptr<gptr<elem<T>>>	rear;
-	};
+	void init(const uint64_t &num);
+	void append(const gptr<elem<T>> &first, const gptr<elem<T>> &last);
+	gptr<gptr<elem<T>>> next_of(const gptr<elem<T>> &addr) const;
+};
 
 } /* namespace msq */
 
 } /* namespace dds */
 
-template <typename T>
-dds::msq::queue<T>::queue()
+template<typename T, template<typename> class M>
+dds::msq::queue<T, M>::queue()
 {
-	//synchronize
-	BCL::barrier();
-
-        front = BCL::alloc<gptr<elem<T>>>(1);
-	rear = BCL::alloc<gptr<elem<T>>>(1);
-	gptr<elem<T>>> dummy = BCL::alloc<elem<T>>(1);
-
-        if (BCL::rank() == MASTER_UNIT)
-        {
-		gptr<gptr<elem<T>>> temp = {dummmy.rank, dummy.ptr};
-		BCL::store(NULL_PTR, temp};
-                BCL::store(dummy, front);
-		BCL::store(dummy, rear);
-                printf("*\tQUEUE\t\t:\tMSQ\t\t\t*\n");
-        }
-        else //if (BCL::rank() != MASTER_UNIT)
-                front.rank = rear.rank = MASTER_UNIT;
-
-	//synchronize
-	BCL::barrier();
+	init(0);
 }
 
-template <typename T>
-dds::msq::queue<T>::~queue()
+template<typename T, template<typename> class M>
+dds::msq::queue<T, M>::queue(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T, template<typename> class M>
+dds::msq::queue<T, M>::~queue()
 {
 	if (BCL::rank() != MASTER_UNIT)
-		front.rank = rear.rank = BCL::rank();
-	BCL::dealloc<gptr<elem<T>>>(front);
-	BCL::dealloc<gptr<elem<T>>>(rear);
+		head.rank = tail.rank = BCL::rank();
+	BCL::dealloc<gptr<elem<T>>>(tail);
+	BCL::dealloc<gptr<elem<T>>>(head);
+}
+
+template<typename T, template<typename> class M>
+bool dds::msq::queue<T, M>::enqueue(const T &value)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	gptr<elem<T>>	newTailAddr;
+
+	// allocate global memory to the new elem
+	newTailAddr = mem.malloc();
+	if (newTailAddr == nullptr)
+	{
+		// end a nonblocking operation
+		mem.op_end();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		// out of memory: push back on the caller
+		return false;
+	}
+
+	// update new element (global memory)
+	if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+		bclx::store({NULL_PTR, value}, newTailAddr);
+	else
+		bclx::rput_sync({NULL_PTR, value}, newTailAddr);
+
+	// link the new elem after the last elem
+	append(newTailAddr, newTailAddr);
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return true;
 }
 
-template <typename T>
-bool dds::msq::queue<T>::enqueue(const T &value)
+template<typename T, template<typename> class M>
+bool dds::msq::queue<T, M>::dequeue(T &value)
 {
-        gptr<elem<T>>   	oldRearAddr,
-                        	newRearAddr;
-	elem<T>			oldRearVal;
-	gptr<gptr<elem<T>>>	tempAddr;
+	// begin a nonblocking operation
+	mem.op_begin();
 
-        //allocate global memory to the new elem
-        newRearAddr = mem.malloc();
-        if (newRearAddr == nullptr)
-                return false;
+	elem<T>		oldHeadNextVal;
+	gptr<elem<T>>	oldHeadAddr,
+			oldHeadNext,
+			oldTailAddr,
+			result;
+	backoff		bk(bk_init, bk_max);
 
-        //update new element (global memory)
-        BCL::rput_sync({NULL_PTR, value}, newRearAddr);
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
 
 	while (true)
 	{
-        	//get rear
-        	oldRearAddr = BCL::aget_sync(rear);
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get head
+		oldHeadAddr = mem.reserve(head);
+
+		// get tail and the successor of head (from global memory to local memory)
+		oldTailAddr = bclx::aget_sync(tail);
+		oldHeadNext = bclx::aget_sync(next_of(oldHeadAddr));
+
+		// check if the queue is empty
+		if (oldHeadNext == nullptr)
+		{
+			// unreserve head
+			mem.unreserve(oldHeadAddr);
+
+			// end a nonblocking operation
+			mem.op_end();
+
+			return false;
+		}
 
-		//get successor of rear
-		oldRearVal = BCL::aget_sync(oldRearAddr);
+		// tail lags behind: swing it forward before head passes it, so that
+		// tail never points to a retired elem
+		if (oldHeadAddr == oldTailAddr)
+		{
+			bclx::cas_sync(tail, oldTailAddr, oldHeadNext);
+			mem.unreserve(oldHeadAddr);
+			continue;
+		}
+
+		// get the value before the CAS: the successor is not reserved, but it
+		// cannot be retired while head stays unchanged, so whatever is read
+		// here is valid if the CAS succeeds
+		oldHeadNextVal = bclx::rget_sync(oldHeadNext);
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(head, oldHeadAddr))
+				continue;
+
+		// try to update head
+		result = bclx::cas_sync(head, oldHeadAddr, oldHeadNext);
+
+		// unreserve head
+		mem.unreserve(oldHeadAddr);
+
+		// check if the update is successful
+		if (result == oldHeadAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
 
-		//are rear and its successor consistent?
-		if (oldRearAddr == BCL::aget_sync(rear))
+			break;
+		}
+		else // if (result != oldHeadAddr)
 		{
-			if (oldRearVal.next == nullptr)
-			{
-				tempAddr = {oldRearAddr.rank, oldRearAddr.ptr};
-				if (BCL::cas_sync(tempAddr, oldRearVal.next, newRearAddr) == oldRearVal.next)
-				       break;	
-			}
-			//else
-			//	BCL::cas_sync(rear, oldRearAddr, oldRearVal.next);
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
 		}
 	}
-	BCL::cas_sync(rear, oldRearAddr, newRearAddr);
+
+	// return the value of the new dummy elem
+	value = oldHeadNextVal.value;
+
+	// deallocate global memory of the old dummy elem
+	mem.retire(oldHeadAddr);
+
+	// end a nonblocking operation
+	mem.op_end();
 
 	return true;
 }
 
-template <typename T>
-bool dds::msq::queue<T>::dequeue(T &value)
+template<typename T, template<typename> class M>
+uint64_t dds::msq::queue<T, M>::enqueue(const T *values, const uint64_t &num)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	std::vector<gptr<elem<T>>>	addrs;
+	uint64_t			i;
+
+	// allocate global memory to the new elems, as many as there is
+	for (i = 0; i < num; ++i)
+	{
+		gptr<elem<T>> addr = mem.malloc();
+		if (addr == nullptr)
+			break;
+		addrs.push_back(addr);
+	}
+	if (addrs.empty())
+	{
+		// end a nonblocking operation
+		mem.op_end();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		// out of memory: push back on the caller
+		return 0;
+	}
+
+	// chain the new elems in order (global memory)
+	for (i = 0; i < addrs.size(); ++i)
+	{
+		elem<T> val = {(i + 1 < addrs.size()) ? addrs[i + 1] : NULL_PTR, values[i]};
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store(val, addrs[i]);
+		else
+			bclx::rput_sync(val, addrs[i]);
+	}
+
+	// link the whole chain after the last elem with one CAS
+	append(addrs.front(), addrs.back());
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return addrs.size();
+}
+
+template<typename T, template<typename> class M>
+uint64_t dds::msq::queue<T, M>::dequeue(T *values, const uint64_t &num)
+{
+	if (num == 0)
+		return 0;
+
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	std::vector<gptr<elem<T>>>	addrs;
+	elem<T>				val;
+	gptr<elem<T>>			oldHeadAddr,
+					oldHeadNext,
+					oldTailAddr,
+					result;
+	backoff				bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get head
+		oldHeadAddr = mem.reserve(head);
+
+		// get tail and the successor of head (from global memory to local memory)
+		oldTailAddr = bclx::aget_sync(tail);
+		oldHeadNext = bclx::aget_sync(next_of(oldHeadAddr));
+
+		// check if the queue is empty
+		if (oldHeadNext == nullptr)
+		{
+			// unreserve head
+			mem.unreserve(oldHeadAddr);
+
+			// end a nonblocking operation
+			mem.op_end();
+
+			return 0;
+		}
+
+		// tail lags behind: swing it forward before head passes it, so that
+		// tail never points to a retired elem
+		if (oldHeadAddr == oldTailAddr)
+		{
+			bclx::cas_sync(tail, oldTailAddr, oldHeadNext);
+			mem.unreserve(oldHeadAddr);
+			continue;
+		}
+
+		// walk up to NUM successors before the CAS, as in a single dequeue,
+		// but stop at tail: head must not pass it
+		addrs.clear();
+		for (result = oldHeadNext; addrs.size() < num; result = val.next)
+		{
+			val = bclx::rget_sync(result);	// one RMA
+			values[addrs.size()] = val.value;
+			addrs.push_back(result);
+			if (val.next == nullptr || result == oldTailAddr)
+				break;
+		}
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(head, oldHeadAddr))
+				continue;
+
+		// try to move head to the last elem taken, which becomes the dummy
+		result = bclx::cas_sync(head, oldHeadAddr, addrs.back());
+
+		// unreserve head
+		mem.unreserve(oldHeadAddr);
+
+		// check if the update is successful
+		if (result == oldHeadAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			break;
+		}
+		else // if (result != oldHeadAddr)
+		{
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
+		}
+	}
+
+	// deallocate global memory of the old dummy elem and of the elems taken
+	// past it, all but the new dummy elem
+	mem.retire(oldHeadAddr);
+	for (uint64_t i = 0; i + 1 < addrs.size(); ++i)
+		mem.retire(addrs[i]);
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return addrs.size();
+}
+
+template<typename T, template<typename> class M>
+void dds::msq::queue<T, M>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		gptr<elem<T>>	headAddr;
+		elem<T>		headVal;
+
+		headVal = bclx::rget_sync(bclx::load(head));
+		for (headAddr = headVal.next; headAddr != nullptr; headAddr = headVal.next)
+		{
+			headVal = bclx::rget_sync(headAddr);
+			printf("value = %d\n", headVal.value);
+			headVal.next.print();
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+void dds::msq::queue<T, M>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	head = BCL::alloc<gptr<elem<T>>>(1);
+	tail = BCL::alloc<gptr<elem<T>>>(1);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		// the queue starts with a dummy elem
+		gptr<elem<T>> dummy = mem.malloc();
+		if (dummy == nullptr)
+		{
+			printf("[%lu]ERROR: queue.queue\n", BCL::rank());
+			return;
+		}
+		bclx::store({NULL_PTR, T()}, dummy);
+		bclx::store(dummy, head);
+		bclx::store(dummy, tail);
+		queue_name = "MSQ";
+	}
+	else
+		head.rank = tail.rank = MASTER_UNIT;
+
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+		for (uint64_t i = 0; i < num; ++i)
+			enqueue(i);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+void dds::msq::queue<T, M>::append(const gptr<elem<T>> &first, const gptr<elem<T>> &last)
 {
-        elem<T>         oldFrontVal;
-        gptr<elem<T>>   oldFrontAddr,
-			oldRearAddr;
+	gptr<elem<T>>	oldTailAddr,
+			oldTailNext;
+	backoff		bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef	TRACING
+		double		start;
+	#endif
 
 	while (true)
 	{
-        	//get front
-        	oldFrontAddr = BCL::aget_sync(front);
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
 
-		//get rear
-		oldRearAddr = BCL::aget_sync(rear);
+		// reserve tail, so that its elem is not reused under the CAS below
+		oldTailAddr = mem.reserve(tail);
 
-		//get successor of front
-		oldFrontVal = BCL::aget_sync(oldFrontAddr);
+		// get the successor of tail (from global memory to local memory)
+		oldTailNext = bclx::aget_sync(next_of(oldTailAddr));
 
-		//are front, its successor and rear consistent?
-		if (oldFrontAddr == BCL::aget_sync(front))
+		// tail lags behind: swing it forward instead of waiting for its enqueuer
+		if (oldTailNext != nullptr)
 		{
-			if (oldFrontAddr == oldRearAddr)
-			{
-				if (oldFrontVal.next == nullptr)
-					return false;
-				BCL::cas_sync(rear, oldRearAddr, oldFrontVal.next);
-			}
-			else
-			{
-				//get value before CAS, otherwise another dequeue might free next node
-				value = BCL::aget_sync(oldFrontVal.next).value;
-				if (BCL::cas_sync(front, oldFrontAddr, oldFrontVal.next)
-						break;
-			}
+			bclx::cas_sync(tail, oldTailAddr, oldTailNext);
+			mem.unreserve(oldTailAddr);
+			continue;
 		}
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(tail, oldTailAddr))
+				continue;
+
+		// try to link the first new elem after the last elem
+		if (bclx::cas_sync(next_of(oldTailAddr), NULL_PTR, first) == NULL_PTR)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			break;
+		}
+
+		// unreserve tail
+		mem.unreserve(oldTailAddr);
+
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			fail_time += (MPI_Wtime() - start);
+			++fail_cs;
+		#endif
 	}
 
-        //deallocate global memory of the popped elem
-        mem.free(oldFrontAddr);
+	// swing tail to the last new elem, unless another unit has already done
+	// so (others swing it one elem at a time along the chain)
+	bclx::cas_sync(tail, oldTailAddr, last);
 
-        return true;
+	// unreserve tail
+	mem.unreserve(oldTailAddr);
 }
 
-template <typename T>
-void dds::msq::queue<T>::print()
+template<typename T, template<typename> class M>
+bclx::gptr<bclx::gptr<dds::msq::elem<T>>> dds::msq::queue<T, M>::next_of(const gptr<elem<T>> &addr) const
 {
-        //synchronize
-        BCL::barrier();
-
-        if (BCL::rank() == MASTER_UNIT)
-        {
-                gptr<elem<T>>   topAddr;
-                elem<T>         topVal;
-
-                for (topAddr = BCL::load(front); topAddr != nullptr; topAddr = topVal.next)
-                {
-                        topVal = BCL::rget_sync(topAddr);
-                        printf("value = %d\n", topVal.value);
-                        topVal.next.print();
-                }
-        }
-
-        //synchronize
-        BCL::barrier();
+	return {addr.rank, addr.ptr};
 }
 
 #endif /* QUEUE_MS_H */
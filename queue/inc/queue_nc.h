@@ -0,0 +1,154 @@
+#ifndef QUEUE_NC_H
+#define QUEUE_NC_H
+
+#include <vector>			// std::vector...
+#include "../../lock/inc/lock_fc.h"	// dds::fc::publication...
+
+namespace dds
+{
+
+namespace ncq
+{
+
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
+enum op_type : uint32_t
+{
+	NONE,
+	ENQUEUE,
+	DEQUEUE
+};
+
+template<typename T>
+using request = fc::request<T>;
+
+template<typename T>
+using response = fc::response<T>;
+
+// a node-local combining front end for a global FIFO queue Q. The units of a
+// compute node post their operations to a publication array hosted by the node
+// leader, and whichever of them takes the node lock applies all pending ones to
+// Q as one batch enqueue and one batch dequeue, then hands out the results.
+// The # operations on Q thus grows with the # compute nodes, not of units.
+// Q must provide enqueue(const T *, num) and dequeue(T *, num), which return
+// the # values actually enqueued or dequeued, in order
+template<typename T, typename Q = msq::queue<T>>
+class queue
+{
+public:
+	queue();			// collective
+	queue(const uint64_t &num);	// collective
+	~queue();			// collective
+	bool enqueue(const T &value);	// non-collective
+	bool dequeue(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	Q			q;	// be the global queue
+	fc::publication<T>	pub;	// be the publication array (hosted by the node leader)
+
+	void init();
+	bool apply(const uint32_t &op, T &value);
+	void combine(const std::vector<request<T>> &req,
+			std::vector<response<T>> &resp,
+			const std::vector<uint64_t> &pending);
+};
+
+} /* namespace ncq */
+
+} /* namespace dds */
+
+template<typename T, typename Q>
+dds::ncq::queue<T, Q>::queue() : q(), pub(fc::NODE)
+{
+	init();
+}
+
+template<typename T, typename Q>
+dds::ncq::queue<T, Q>::queue(const uint64_t &num) : q(num), pub(fc::NODE)
+{
+	init();
+}
+
+template<typename T, typename Q>
+dds::ncq::queue<T, Q>::~queue() {}
+
+template<typename T, typename Q>
+bool dds::ncq::queue<T, Q>::enqueue(const T &value)
+{
+	T temp = value;
+	return apply(ENQUEUE, temp);
+}
+
+template<typename T, typename Q>
+bool dds::ncq::queue<T, Q>::dequeue(T &value)
+{
+	return apply(DEQUEUE, value);
+}
+
+template<typename T, typename Q>
+void dds::ncq::queue<T, Q>::print()
+{
+	q.print();
+}
+
+template<typename T, typename Q>
+void dds::ncq::queue<T, Q>::init()
+{
+	if (BCL::rank() == MASTER_UNIT)
+		queue_name = "NC-" + queue_name;
+}
+
+template<typename T, typename Q>
+bool dds::ncq::queue<T, Q>::apply(const uint32_t &op, T &value)
+{
+	// every unit of the node becomes its combiner whenever the lock is free
+	response<T> resp = pub.apply(op, value, 0,
+			[this](const std::vector<request<T>> &req, std::vector<response<T>> &resp,
+				const std::vector<uint64_t> &pending) { combine(req, resp, pending); });
+
+	if (op == DEQUEUE)
+		value = resp.value;
+	return resp.status;
+}
+
+template<typename T, typename Q>
+void dds::ncq::queue<T, Q>::combine(const std::vector<request<T>> &req, std::vector<response<T>> &resp, const std::vector<uint64_t> &pending)
+{
+	std::vector<uint64_t>		enqs,
+					deqs;
+	std::vector<T>			vals;
+	uint64_t			num;
+
+	for (uint64_t i : pending)
+		if (req[i].op == ENQUEUE)
+			enqs.push_back(i);
+		else // if (req[i].op == DEQUEUE)
+			deqs.push_back(i);
+
+	// apply the enqueues in one batch
+	if (!enqs.empty())
+	{
+		for (uint64_t i : enqs)
+			vals.push_back(req[i].value);
+		num = q.enqueue(vals.data(), vals.size());	// remote
+		for (uint64_t i = 0; i < enqs.size(); ++i)
+			resp[enqs[i]] = {req[enqs[i]].seq, i < num, req[enqs[i]].value};
+	}
+
+	// apply the dequeues in one batch, after the enqueues of the same batch
+	if (!deqs.empty())
+	{
+		vals.resize(deqs.size());
+		num = q.dequeue(vals.data(), vals.size());	// remote
+		for (uint64_t i = 0; i < deqs.size(); ++i)
+			if (i < num)
+				resp[deqs[i]] = {req[deqs[i]].seq, true, vals[i]};
+			else // if the queue is empty
+				resp[deqs[i]] = {req[deqs[i]].seq, false, T()};
+	}
+}
+
+#endif /* QUEUE_NC_H */
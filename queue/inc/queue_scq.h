@@ -0,0 +1,363 @@
+#ifndef QUEUE_SCQ_H
+#define QUEUE_SCQ_H
+
+#include <cstdint>	// uint64_t...
+
+namespace dds
+{
+
+namespace scq
+{
+
+using namespace bclx;
+
+/* Constants */
+const uint64_t	FINALIZED	= uint64_t(1) << 63;	// be the tail bit closing a ring to enqueues
+const uint64_t	SAFE		= uint64_t(1) << 32;	// be the entry bit allowing an enqueue behind head
+const uint64_t	BOTTOM		= 0xffffffff;		// be the index of a vacant entry
+const uint64_t	CYCLE_SHIFT	= 33;			// be the position of the cycle of an entry
+
+/* Datatypes */
+
+// a ring of 2 * cap entries holding up to cap indices in [0, cap). Units claim
+// entries with one fetch-and-add on head or tail, and only the entry of their
+// ticket is updated with a CAS, so the CAS never contends with more than the
+// few units whose tickets map to the same entry [Nikolaev, DISC'19]
+class ring
+{
+public:
+	ring();
+	ring(const gptr<uint64_t> &base, const uint64_t &cap);
+	static uint64_t words(const uint64_t &cap);
+	void init(const bool &full);			// local
+	bool enqueue(const uint64_t &index);		// non-collective
+	bool dequeue(uint64_t &index);			// non-collective
+	void finalize();				// non-collective
+	void reset();					// non-collective
+
+private:
+	gptr<uint64_t>	head;		// be the ticket of the next dequeue
+	gptr<uint64_t>	tail;		// be the ticket of the next enqueue (and the FINALIZED bit)
+	gptr<uint64_t>	threshold;	// be the # dequeues left before the ring is found empty (signed)
+	gptr<uint64_t>	entries;	// be the cycle, the SAFE bit and the index of each entry
+	uint64_t	cap;		// be the # indices the ring can hold
+	uint64_t	size;		// be the # entries of the ring
+
+	uint64_t cycle_of(const uint64_t &ticket) const;
+	uint64_t entry_of(const uint64_t &cycle, const uint64_t &safe, const uint64_t &index) const;
+	void catchup(uint64_t tailVal, uint64_t headVal);
+};
+
+template<typename T>
+class queue
+{
+public:
+	queue(const uint64_t &cap);			// collective
+	queue(const uint64_t &cap, const uint64_t &num);	// collective
+	~queue();					// collective
+	bool enqueue(const T &value);			// non-collective
+	bool dequeue(T &value);				// non-collective
+
+private:
+	gptr<uint64_t>	base;	// be the rings and the values of the queue (hosted by MASTER_UNIT)
+	ring		aq;	// contain the indices of the allocated values
+	ring		fq;	// contain the indices of the free values
+	gptr<T>		items;	// be the values of the queue
+
+	void init(const uint64_t &cap, const uint64_t &num);
+};
+
+} /* namespace scq */
+
+} /* namespace dds */
+
+dds::scq::ring::ring() : cap{0}, size{0} {}
+
+dds::scq::ring::ring(const gptr<uint64_t> &base, const uint64_t &cap)
+	: head{base}, tail{base + 1}, threshold{base + 2}, entries{base + 3}, cap{cap}, size{2 * cap} {}
+
+uint64_t dds::scq::ring::words(const uint64_t &cap)
+{
+	return 3 + 2 * cap;
+}
+
+void dds::scq::ring::init(const bool &full)
+{
+	uint64_t	i;
+
+	// the first tickets are of cycle 1, so that every entry of cycle 0 is usable
+	for (i = 0; i < size; ++i)
+		bclx::store(entry_of(0, SAFE, BOTTOM), entries + i);	// local
+	bclx::store(size, head);	// local
+	if (full)
+	{
+		for (i = 0; i < cap; ++i)
+			bclx::store(entry_of(1, SAFE, i), entries + i);	// local
+		bclx::store(size + cap, tail);			// local
+		bclx::store(uint64_t(3 * cap - 1), threshold);	// local
+	}
+	else // if (!full)
+	{
+		bclx::store(size, tail);		// local
+		bclx::store(uint64_t(-1), threshold);	// local
+	}
+}
+
+bool dds::scq::ring::enqueue(const uint64_t &index)
+{
+	uint64_t	tailVal,
+			entry,
+			result;
+	gptr<uint64_t>	slot;
+
+	while (true)
+	{
+		// claim a ticket
+		tailVal = bclx::fao_sync(tail, uint64_t(1), BCL::plus<uint64_t>{});	// one RMA
+		if (tailVal & FINALIZED)
+			return false;
+		slot = entries + tailVal % size;
+		entry = bclx::aget_sync(slot);	// one RMA
+
+		// the entry is usable if it is vacant and of a past cycle, and either no
+		// dequeuer has given up on it or head has not passed the ticket yet
+		while ((entry >> CYCLE_SHIFT) < cycle_of(tailVal) && (entry & BOTTOM) == BOTTOM &&
+			((entry & SAFE) || bclx::aget_sync(head) <= tailVal))
+		{
+			result = bclx::cas_sync(slot, entry, entry_of(cycle_of(tailVal), SAFE, index));	// one RMA
+			if (result == entry)
+			{
+				// tell dequeuers that the ring is not empty
+				if (bclx::aget_sync(threshold) != 3 * cap - 1)			// one RMA
+					bclx::aput_sync(uint64_t(3 * cap - 1), threshold);	// one RMA
+				return true;
+			}
+			entry = result;
+
+			// tracing
+			#ifdef	TRACING
+				++fail_cs;
+			#endif
+		}
+	}
+}
+
+bool dds::scq::ring::dequeue(uint64_t &index)
+{
+	uint64_t	headVal,
+			tailVal,
+			entry,
+			newEntry,
+			result;
+	gptr<uint64_t>	slot;
+
+	// the ring has been found empty since the last enqueue
+	if (int64_t(bclx::aget_sync(threshold)) < 0)	// one RMA
+		return false;
+
+	while (true)
+	{
+		// claim a ticket
+		headVal = bclx::fao_sync(head, uint64_t(1), BCL::plus<uint64_t>{});	// one RMA
+		slot = entries + headVal % size;
+		entry = bclx::aget_sync(slot);	// one RMA
+
+		while (true)
+		{
+			// the entry holds the index enqueued for the ticket: consume it by
+			// setting its index to BOTTOM, keeping whatever SAFE bit it has now
+			if ((entry >> CYCLE_SHIFT) == cycle_of(headVal))
+			{
+				bclx::fao_sync(slot, (entry & BOTTOM) ^ BOTTOM, BCL::xor_<uint64_t>{});	// one RMA
+				index = entry & BOTTOM;
+				return true;
+			}
+
+			// the enqueuer of the ticket is late: advance a vacant entry to the
+			// cycle of the ticket, or mark an occupied one unsafe for it
+			if ((entry & BOTTOM) == BOTTOM)
+				newEntry = entry_of(cycle_of(headVal), entry & SAFE, BOTTOM);
+			else // if ((entry & BOTTOM) != BOTTOM)
+				newEntry = entry & ~SAFE;
+			if ((entry >> CYCLE_SHIFT) < cycle_of(headVal))
+			{
+				result = bclx::cas_sync(slot, entry, newEntry);	// one RMA
+				if (result != entry)
+				{
+					entry = result;
+					continue;
+				}
+			}
+			break;
+		}
+
+		// head has passed tail: pull tail up, so that no enqueuer takes a passed ticket
+		tailVal = bclx::aget_sync(tail);	// one RMA
+		if ((tailVal & ~FINALIZED) <= headVal + 1)
+		{
+			catchup(tailVal, headVal + 1);
+			bclx::fao_sync(threshold, uint64_t(-1), BCL::plus<uint64_t>{});	// one RMA
+			return false;
+		}
+		if (int64_t(bclx::fao_sync(threshold, uint64_t(-1), BCL::plus<uint64_t>{})) <= 0)	// one RMA
+			return false;
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+	}
+}
+
+void dds::scq::ring::finalize()
+{
+	uint64_t	tailVal,
+			result;
+
+	tailVal = bclx::aget_sync(tail);	// one RMA
+	while (!(tailVal & FINALIZED))
+	{
+		result = bclx::cas_sync(tail, tailVal, tailVal | FINALIZED);	// one RMA
+		if (result == tailVal)
+			break;
+		tailVal = result;
+	}
+}
+
+void dds::scq::ring::reset()
+{
+	bclx::aput_sync(uint64_t(3 * cap - 1), threshold);	// one RMA
+}
+
+uint64_t dds::scq::ring::cycle_of(const uint64_t &ticket) const
+{
+	return ((ticket & ~FINALIZED) / size) & (BOTTOM >> 1);
+}
+
+uint64_t dds::scq::ring::entry_of(const uint64_t &cycle, const uint64_t &safe, const uint64_t &index) const
+{
+	return (cycle << CYCLE_SHIFT) | safe | index;
+}
+
+void dds::scq::ring::catchup(uint64_t tailVal, uint64_t headVal)
+{
+	uint64_t	result;
+
+	while (true)
+	{
+		result = bclx::cas_sync(tail, tailVal, headVal | (tailVal & FINALIZED));	// one RMA
+		if (result == tailVal)
+			break;
+		tailVal = result;
+		headVal = bclx::aget_sync(head);	// one RMA
+		if ((tailVal & ~FINALIZED) >= headVal)
+			break;
+	}
+}
+
+template<typename T>
+dds::scq::queue<T>::queue(const uint64_t &cap)
+{
+	init(cap, 0);
+}
+
+template<typename T>
+dds::scq::queue<T>::queue(const uint64_t &cap, const uint64_t &num)
+{
+	init(cap, num);
+}
+
+template<typename T>
+dds::scq::queue<T>::~queue()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	base.rank = BCL::rank();
+	BCL::dealloc<uint64_t>(base);
+}
+
+template<typename T>
+bool dds::scq::queue<T>::enqueue(const T &value)
+{
+	uint64_t	index;
+
+	// take a free value, the queue is full if there is none
+	if (!fq.dequeue(index))
+	{
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		return false;
+	}
+
+	// update the value, then publish its index
+	bclx::rput_sync(value, items + index);	// one RMA
+	aq.enqueue(index);
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+bool dds::scq::queue<T>::dequeue(T &value)
+{
+	uint64_t	index;
+
+	// take the index of the oldest value, the queue is empty if there is none
+	if (!aq.dequeue(index))
+		return false;
+
+	// get the value, then free it
+	value = bclx::rget_sync(items + index);	// one RMA
+	fq.enqueue(index);
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+void dds::scq::queue<T>::init(const uint64_t &cap, const uint64_t &num)
+{
+	uint64_t	words = 2 * ring::words(cap) + (cap * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	// synchronize
+	bclx::barrier_sync();
+
+	// the rings and the values are laid out in one block: aq, fq, items. Every
+	// unit allocates it, so that later allocations stay at the same offsets on
+	// every unit, but only the block of MASTER_UNIT is used
+	base = BCL::alloc<uint64_t>(words);
+	if (base == nullptr)
+		printf("[%lu]ERROR: queue.queue\n", BCL::rank());
+	if (BCL::rank() == MASTER_UNIT)
+		queue_name = "SCQ";
+	else
+		base.rank = MASTER_UNIT;
+	aq = ring(base, cap);
+	fq = ring(base + ring::words(cap), cap);
+	items = gptr<T>{base.rank, (base + 2 * ring::words(cap)).ptr};
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		aq.init(false);
+		fq.init(true);
+		for (uint64_t i = 0; i < num; ++i)
+			enqueue(i);
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+#endif /* QUEUE_SCQ_H */
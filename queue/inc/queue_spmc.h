@@ -4,11 +4,18 @@
 #include <vector>	// std::vector...
 #include <cstdint>	// uint64_t...
 #include <utility>	// std::move...
-#include <algorith>	// std::min...
+#include <algorithm>	// std::min...
 
 namespace dds
 {
 
+// a bounded ring hosted by its producer. A consumer claims a range of up to
+// BOUND_DEQUEUE values with one fetch-and-add on head, gets the whole range
+// with one get, and then marks its slots consumed. Under contention a claim
+// may run ahead of the published tail; its consumer gets the rest of the
+// range on its next dequeues, once the producer has published it. The
+// producer publishes tail lazily, and only reads the marks when its cached
+// view of the consumed slots leaves no room for a batch
 template<typename T>
 class queue_spmc
 {
@@ -17,18 +24,26 @@ public:
 		const uint64_t&		cap);
 	~queue_spmc();
 	void clear();
-	void enqueue(const std::vector<T>& vals);
+	bool enqueue(const std::vector<T>& vals);
+	bool enqueue(const T* vals, const uint64_t& n);
 	bool dequeue(std::vector<T>& vals);
+	void flush();
 
 private:
 	const uint64_t	BOUND_DEQUEUE	= 100;
 
-	uint64_t	host;
-	uint64_t	capacity;
-	uint64_t	tail_local;
-	gptr<uint64_t>	head;
-	gptr<uint64_t>	tail;
-	gptr<T>		items;
+	const uint64_t		HOST;
+	const uint64_t		CAPACITY;
+	uint64_t		tail_local;	// be the produced values (producer), or last seen (consumer)
+	uint64_t		free_local;	// be the values known to be consumed in order (producer)
+	uint64_t		claim_begin;	// be the first claimed value not dequeued yet (consumer)
+	uint64_t		claim_end;	// be the end of the claimed range (consumer)
+	bclx::gptr<uint64_t>	head;
+	bclx::gptr<uint64_t>	tail;
+	bclx::gptr<uint64_t>	marks;		// be the position last consumed from each slot
+	bclx::gptr<T>		items;
+
+	void mark(const uint64_t& begin, const uint64_t& end);
 };
 
 } /* namespace dds */
@@ -36,81 +51,160 @@ private:
 template<typename T>
 dds::queue_spmc<T>::queue_spmc(const uint64_t&	host,
 				const uint64_t& cap)
-	: host{host}, capacity{cap}, tail_local{0}
+	: HOST{host}, CAPACITY{cap}, tail_local{0}, free_local{0}, claim_begin{0}, claim_end{0}
 {
-	if (BCL::rank() == host)
+	if (BCL::rank() == HOST)
 	{
 		head = BCL::alloc<uint64_t>(1);
+		bclx::store(uint64_t(0), head);
 		tail = BCL::alloc<uint64_t>(1);
-		BCL::store(uint64_t(0), head);
-		BCL::store(uint64_t(0), tail);
+		bclx::store(uint64_t(0), tail);
+
+		// no slot has been consumed at any position yet
+		marks = BCL::alloc<uint64_t>(CAPACITY);
+		for (uint64_t i = 0; i < CAPACITY; ++i)
+			bclx::store(uint64_t(-1), marks + i);
 
-		items = BCL::alloc<T>(cap);
+		items = BCL::alloc<T>(CAPACITY);
 	}
 
-	// synchronize	
-	head = BCL::broadcast(head, host);
-	tail = BCL::broadcast(tail, host);
-	items = BCL::broadcast(items, host);
+	// synchronize
+	head = BCL::broadcast(head, HOST);
+	tail = BCL::broadcast(tail, HOST);
+	marks = BCL::broadcast(marks, HOST);
+	items = BCL::broadcast(items, HOST);
 }
 
 template<typename T>
-dds::queue_spmc<T>::~queue_spmc()
-{
-	/* No-op */
-}
+dds::queue_spmc<T>::~queue_spmc() {}
 
 template<typename T>
 void dds::queue_spmc<T>::clear()
 {
-	if (BCL::rank() == host)
+	if (BCL::rank() == HOST)
 	{
 		BCL::dealloc<uint64_t>(head);
 		BCL::dealloc<uint64_t>(tail);
+		BCL::dealloc<uint64_t>(marks);
 		BCL::dealloc<T>(items);
 	}
 }
 
 template<typename T>
-void dds::queue_spmc<T>::enqueue(const std::vector<T>& vals)
+bool dds::queue_spmc<T>::enqueue(const std::vector<T>& vals)
+{
+	return enqueue(vals.data(), vals.size());
+}
+
+template<typename T>
+bool dds::queue_spmc<T>::enqueue(const T* vals, const uint64_t& n)
 {
-	gptr<T> temp = items + tail_local % capacity;
-	const T* array = &vals[0];
-	BCL::rput_sync(array, temp, vals.size());	// remote
-	tail_local += vals.size();
-	BCL::aput_sync(tail_local, tail);	// remote
+	// the ring is full as far as the producer knows: skip the slots consumed since
+	if (tail_local + n - free_local > CAPACITY)
+	{
+		std::vector<uint64_t> buf;
+		while (free_local < tail_local)
+		{
+			uint64_t offset = free_local % CAPACITY;
+			uint64_t length = std::min(tail_local - free_local, CAPACITY - offset);
+			buf.resize(length);
+			bclx::aget_sync(marks + offset, buf.data(), length);	// local
+			uint64_t i = 0;
+			while (i < length && buf[i] == free_local + i)
+				++i;
+			free_local += i;
+			if (i < length)
+				break;
+		}
+		if (tail_local + n - free_local > CAPACITY)
+			return false;	// the queue is full now
+	}
+
+	uint64_t offset = tail_local % CAPACITY;
+	bclx::gptr<T> location = items + offset;
+	if (offset + n <= CAPACITY)
+		bclx::rput_async(vals, location, n);	// local
+	else // if (offset + n > CAPACITY)
+	{
+		uint64_t size = CAPACITY - offset;
+		bclx::rput_async(vals, location, size);	// local
+		uint64_t size2 = n - size;
+		bclx::rput_async(vals + size, items, size2);	// local
+	}
+
+	// complete the items together with the previous tail update
+	bclx::flush(HOST);	// local
+
+	// the new tail is completed by the next flush
+	tail_local += n;
+	bclx::aput_async(tail_local, tail);	// local
+	return true;
 }
 
 template<typename T>
 bool dds::queue_spmc<T>::dequeue(std::vector<T>& vals)
 {
-	uint64_t	size,
-			head_old,
-			head_new,
-			result;
-
-	tail_local = BCL::aget_sync(tail);	// local
-	head_old = BCL::aget_sync(head);	// local
-	while (true)	// lock-free loop
+	// the previous range has been dequeued: claim a new one
+	if (claim_begin == claim_end)
 	{
-		size = tail_local - head_old;
-		if (size == 0)
+		tail_local = bclx::aget_sync(tail);	// remote
+		uint64_t head_old = bclx::aget_sync(head);	// remote
+		if (head_old >= tail_local)
 			return false;	// the queue is empty now
-		size_bound = std::min(size, BOUND_DEQUEUE);
-		head_new += size_bound;
-		result = BCL::cas_sync(head, head_old, head_new);	// local
-		if (result == head_old)
-			break;
-		else // if (result != head_old)
-			head_old = result;
+		uint64_t size = std::min(tail_local - head_old, BOUND_DEQUEUE);
+		claim_begin = bclx::fao_sync(head, size, BCL::plus<uint64_t>{});	// remote
+		claim_end = claim_begin + size;
 	}
-	gptr<T> temp = items + head_old % capacity;
-	T* array = new T[size_bound];
-	BCL::load(temp, array, size_bound);	// local
-	for (uint64_t i = 0; i < size_bound; ++i)
-		vals.push_back(array[i]);
-	delete[] array;
+	else if (claim_begin >= tail_local)
+		tail_local = bclx::aget_sync(tail);	// remote
+
+	// get the part of the range published so far
+	uint64_t end = std::min(claim_end, tail_local);
+	if (end <= claim_begin)
+		return false;	// the range has not been published yet
+	uint64_t length = end - claim_begin;
+	uint64_t offset = claim_begin % CAPACITY;
+	uint64_t first = vals.size();
+	vals.resize(first + length);
+	if (offset + length <= CAPACITY)
+		bclx::rget_sync(items + offset, vals.data() + first, length);	// remote
+	else // if (offset + length > CAPACITY)
+	{
+		uint64_t size = CAPACITY - offset;
+		bclx::rget_async(items + offset, vals.data() + first, size);	// remote
+		bclx::rget_async(items, vals.data() + first + size, length - size);	// remote
+		bclx::flush(HOST);	// remote
+	}
+
+	// the producer may overwrite the slots from now on
+	mark(claim_begin, end);
+	claim_begin = end;
 	return true;
 }
 
+template<typename T>
+void dds::queue_spmc<T>::flush()
+{
+	bclx::flush(HOST);	// remote
+}
+
+template<typename T>
+void dds::queue_spmc<T>::mark(const uint64_t& begin, const uint64_t& end)
+{
+	std::vector<uint64_t> positions(end - begin);
+	for (uint64_t i = 0; i < positions.size(); ++i)
+		positions[i] = begin + i;
+
+	uint64_t offset = begin % CAPACITY;
+	if (offset + positions.size() <= CAPACITY)
+		bclx::aput_sync(positions.data(), marks + offset, positions.size());	// remote
+	else // if (offset + positions.size() > CAPACITY)
+	{
+		uint64_t size = CAPACITY - offset;
+		bclx::aput_async(positions.data(), marks + offset, size);	// remote
+		bclx::aput_async(positions.data() + size, marks, positions.size() - size);	// remote
+		bclx::flush(HOST);	// remote
+	}
+}
+
 #endif /* QUEUE_SPMC_H */
@@ -4,26 +4,44 @@
 #include <vector>	// std::vector...
 #include <cstdint>	// uint64_t...
 #include <utility>	// std::move...
+#include <algorithm>	// std::min...
 
 namespace dds
 {
 
+// a bounded ring hosted by its consumer. The producer writes the values and
+// then the tail, and only reads the head of the consumer when its cached copy
+// no longer leaves room for a batch, so a batch costs one flush in the common
+// case. The consumer reads the values in place
 template<typename T>
 class queue_spsc
 {
 public:
+	struct view
+	{
+		const T*	data;	// point to the oldest value in the ring
+		uint64_t	size;	// be the # contiguous values from data
+	};
+
 	queue_spsc(const uint64_t&	host,
 		const uint64_t&		cap);
 	~queue_spsc();
 	void clear();
-	void enqueue(const std::vector<T>& vals);
+	bool enqueue(const std::vector<T>& vals);
+	bool enqueue(const T* vals, const uint64_t& n);
+	uint64_t room(const uint64_t& n);
 	bool dequeue(std::vector<T>& vals);
+	view peek();
+	void commit(const uint64_t& n);
+	void flush();
 
 private:
 	const uint64_t		HOST;
 	const uint64_t		CAPACITY;
-	uint64_t		head;
-	uint64_t		tail_local;
+	uint64_t		head_local;	// be the consumed values (consumer)
+	uint64_t		head_cache;	// be the consumed values last seen (producer)
+	uint64_t		tail_local;	// be the produced values (producer), or last seen (consumer)
+	bclx::gptr<uint64_t>	head;
 	bclx::gptr<uint64_t>	tail;
 	bclx::gptr<T>		items;
 };
@@ -33,17 +51,20 @@ private:
 template<typename T>
 dds::queue_spsc<T>::queue_spsc(const uint64_t&	host,
 				const uint64_t& cap)
-	: HOST{host}, CAPACITY{cap}, head{0}, tail_local{0}
+	: HOST{host}, CAPACITY{cap}, head_local{0}, head_cache{0}, tail_local{0}
 {
 	if (BCL::rank() == HOST)
 	{
+		head = BCL::alloc<uint64_t>(1);
+		bclx::store(uint64_t(0), head);
 		tail = BCL::alloc<uint64_t>(1);
 		bclx::store(uint64_t(0), tail);
 
 		items = BCL::alloc<T>(CAPACITY);
 	}
 
-	// synchronize	
+	// synchronize
+	head = BCL::broadcast(head, HOST);
 	tail = BCL::broadcast(tail, HOST);
 	items = BCL::broadcast(items, HOST);
 }
@@ -56,54 +77,93 @@ void dds::queue_spsc<T>::clear()
 {
 	if (BCL::rank() == HOST)
 	{
+		BCL::dealloc<uint64_t>(head);
 		BCL::dealloc<uint64_t>(tail);
 		BCL::dealloc<T>(items);
 	}
 }
 
 template<typename T>
-void dds::queue_spsc<T>::enqueue(const std::vector<T>& vals)
+bool dds::queue_spsc<T>::enqueue(const std::vector<T>& vals)
+{
+	return enqueue(vals.data(), vals.size());
+}
+
+template<typename T>
+bool dds::queue_spsc<T>::enqueue(const T* vals, const uint64_t& n)
 {
+	if (room(n) < n)
+		return false;	// the queue is full now
+
 	uint64_t offset = tail_local % CAPACITY;
 	bclx::gptr<T> location = items + offset;
-	const T* array = &vals[0];
-	if (offset + vals.size() <= CAPACITY)
-		bclx::rput_sync(array, location, vals.size());	// remote
-	else // if (offset + vals.size() > CAPACITY)
+	if (offset + n <= CAPACITY)
+		bclx::rput_async(vals, location, n);	// remote
+	else // if (offset + n > CAPACITY)
 	{
 		uint64_t size = CAPACITY - offset;
-		bclx::rput_sync(array, location, size);	// remote;
-		uint64_t size2 = vals.size() - size;
-		bclx::rput_sync(array + size, items, size2);	// remote
+		bclx::rput_async(vals, location, size);	// remote
+		uint64_t size2 = n - size;
+		bclx::rput_async(vals + size, items, size2);	// remote
 	}
-	tail_local += vals.size();
-	bclx::aput_sync(tail_local, tail);	// remote
+
+	// complete the items together with the previous tail update
+	bclx::flush(HOST);	// remote
+
+	// the new tail is completed by the next flush
+	tail_local += n;
+	bclx::aput_async(tail_local, tail);	// remote
+	return true;
+}
+
+template<typename T>
+uint64_t dds::queue_spsc<T>::room(const uint64_t& n)
+{
+	// the ring is full as far as the producer knows: refresh the head
+	if (tail_local + n - head_cache > CAPACITY)
+		head_cache = bclx::aget_sync(head);	// remote
+	return CAPACITY - (tail_local - head_cache);
 }
 
 template<typename T>
 bool dds::queue_spsc<T>::dequeue(std::vector<T>& vals)
 {
-	tail_local = bclx::aget_sync(tail);	// local
-	uint64_t length = tail_local - head;
-	if (length == 0)
+	view v = peek();
+	if (v.size == 0)
 		return false;	// the queue is empty now
-	uint64_t offset = head % CAPACITY;
-	bclx::gptr<T> location = items + offset;
-	T* array = new T[length];
-	if (offset + length <= CAPACITY)
-		bclx::load(location, array, length);	// local
-	else // if (offset + length > CAPACITY)
-	{
-		uint64_t size = CAPACITY - offset;	// local
-		bclx::load(location, array, size);
-		uint64_t size2 = length - size;
-		bclx::load(location, array + size, size2);	// local
-	}
-	for (uint64_t i = 0; i < length; ++i)
-		vals.push_back(array[i]);
-	delete[] array;
-	head += vals.size();
+	vals.insert(vals.end(), v.data, v.data + v.size);	// local
+	commit(v.size);
+
+	// the values wrap around the end of the ring
+	v = peek();
+	vals.insert(vals.end(), v.data, v.data + v.size);	// local
+	commit(v.size);
 	return true;
 }
 
+template<typename T>
+typename dds::queue_spsc<T>::view dds::queue_spsc<T>::peek()
+{
+	tail_local = bclx::aget_sync(tail);	// local
+	uint64_t offset = head_local % CAPACITY;
+	uint64_t length = std::min(tail_local - head_local, CAPACITY - offset);
+	return {items.local() + offset, length};
+}
+
+template<typename T>
+void dds::queue_spsc<T>::commit(const uint64_t& n)
+{
+	// the values of the view may be overwritten from now on
+	if (n == 0)
+		return;
+	head_local += n;
+	bclx::aput_sync(head_local, head);	// local
+}
+
+template<typename T>
+void dds::queue_spsc<T>::flush()
+{
+	bclx::flush(HOST);	// remote
+}
+
 #endif /* QUEUE_SPSC_H */
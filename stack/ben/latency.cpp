@@ -0,0 +1,163 @@
+#include <random>			// std::mt19937...
+#include <cstdint>			// uint32_t...
+#include <string>			// std::string...
+#include <vector>			// std::vector...
+#include <bclx/bclx.hpp>		// BCL::init...
+#include "../inc/stack_factory.h"	// dds::make_stack...
+
+using namespace dds;
+
+// usage: latency [stack,...] [memory,...] [push%,...] [rate,...] [units,...]
+//	rate:	ops/s issued by each unit on a fixed schedule (open loop), 0 for
+//		a closed loop thinking WORKLOAD us between ops
+//	units:	# units issuing ops, the others stay idle (default: 2, 4, ..., all)
+// e.g. latency ts,ebs3 hp,nbr 50,90 0,100000 runs every stack with every memory
+// manager at 50% and 90% pushes, closed loop and 100 kops/s per unit
+int main(int argc, char *argv[])
+{
+	uint32_t	value;
+	uint64_t	num_ops,
+			period,
+			next,
+			start,
+			empty,
+			full;
+	double		elapsed_time,
+			total_time;
+	bclx::timer	tim;
+	bclx::histogram	lat_push,
+			lat_pop;
+
+	BCL::init();
+
+	std::vector<std::string>	variants = bclx::split(argc > 1 ? argv[1] : "ts"),
+					mem_names = bclx::split(argc > 2 ? argv[2] : "");
+	std::vector<uint64_t>		mixes = bclx::split_num(argc > 3 ? argv[3] : "50"),
+					rates = bclx::split_num(argc > 4 ? argv[4] : "0"),
+					units = bclx::split_num(argc > 5 ? argv[5] : "");
+
+	if (units.empty())
+	{
+		for (uint64_t i = 2; i < BCL::nprocs(); i *= 2)
+			units.push_back(i);
+		units.push_back(BCL::nprocs());
+	}
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		printf("*********************************************************\n");
+		printf("*\tBENCHMARK\t:\tLatency\t\t\t*\n");
+		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+		printf("*\tNUM_OPS\t\t:\t%lu (ops)\t\t*\n", TOTAL_OPS / 2);
+		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+		printf("*********************************************************\n");
+		printf("stack, memory, units, push%%, rate (ops/s/unit), op, count, "
+				"mean (ns), p50 (ns), p99 (ns), p999 (ns), max (ns), throughput (ops/s)\n");
+	}
+
+	for (const std::string &variant : variants)
+	for (const std::string &mem_name : mem_names)
+	for (uint64_t active : units)
+	for (uint64_t mix : mixes)
+	for (uint64_t rate : rates)
+	{
+		if (active == 0 || active > BCL::nprocs())
+			continue;
+
+		// tracing
+		#ifdef	TRACING
+			succ_cs = fail_cs = succ_ea = fail_ea = elem_rc = elem_ru = 0;
+			fail_time = 0;
+			mstats = mem_stats();
+		#endif
+
+		// the initial elems cover every pop, and no unit pushes more than its pool holds
+		stack_name = mem_manager = "";
+		std::unique_ptr<stack<uint32_t>> myStack = make_stack<uint32_t>(variant, mem_name, TOTAL_OPS / 2);
+		if (myStack == nullptr)
+			continue;
+		num_ops = (BCL::rank() < active) ? TOTAL_OPS / 2 / active : 0;
+
+		std::mt19937				gen(BCL::rank());
+		std::uniform_int_distribution<uint64_t>	dist(0, 99);
+		period = (rate == 0) ? 0 : 1000000000 / rate;
+		lat_push.reset();
+		lat_pop.reset();
+		empty = full = 0;
+
+		// synchronize
+		bclx::barrier_sync();
+
+		tim.reset();
+		tim.start();	// start the timer
+
+		next = bclx::now();
+		for (uint64_t i = 0; i < num_ops; ++i)
+		{
+			// an open loop measures from the scheduled arrival, so that a slow op
+			// also charges the ops queued behind it (no coordinated omission)
+			if (period != 0)
+			{
+				while (bclx::now() < next);
+				start = next;
+				next += period;
+			}
+			else
+				start = bclx::now();
+
+			if (dist(gen) < mix)
+			{
+				// a push out of memory has not completed, so it has no latency
+				if (myStack->push(i))
+					lat_push.record(bclx::now() - start);
+				else
+					++full;
+			}
+			else
+			{
+				if (!myStack->pop(value))
+					++empty;
+				lat_pop.record(bclx::now() - start);
+			}
+
+			if (period == 0)
+				bclx::think(uint64_t(WORKLOAD) * 1000);
+		}
+
+		tim.stop();	// stop the timer
+
+		elapsed_time = tim.get();
+		if (period == 0)
+			elapsed_time -= ((double) num_ops * WORKLOAD) / 1000000;
+
+		total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+		empty = bclx::reduce(empty, MASTER_UNIT, BCL::sum<uint64_t>{});
+		full = bclx::reduce(full, MASTER_UNIT, BCL::sum<uint64_t>{});
+		bclx::histogram	total_push = lat_push.reduce(BCL::comm, MASTER_UNIT),
+				total_pop = lat_pop.reduce(BCL::comm, MASTER_UNIT);
+		if (BCL::rank() == MASTER_UNIT)
+		{
+			const bclx::histogram	*hists[] = {&total_push, &total_pop};
+			const char		*ops[] = {"push", "pop"};
+
+			for (uint32_t j = 0; j < 2; ++j)
+				printf("%s, %s, %lu, %lu, %lu, %s, %lu, %.0f, %lu, %lu, %lu, %lu, %f\n",
+						stack_name.c_str(), mem_manager.c_str(), active, mix, rate,
+						ops[j], hists[j]->count(), hists[j]->mean(),
+						hists[j]->percentile(50), hists[j]->percentile(99),
+						hists[j]->percentile(99.9), hists[j]->max(),
+						(TOTAL_OPS / 2 / active * active) / total_time);
+			if (empty > 0)
+				printf("[%lu]WARNING: %lu pops found the stack empty\n", BCL::rank(), empty);
+			if (full > 0)
+				printf("[%lu]WARNING: %lu pushes ran out of memory\n", BCL::rank(), full);
+		}
+
+		// destroy the stack before creating the next one
+		myStack.reset();
+	}
+
+	BCL::finalize();
+
+	return 0;
+}
@@ -1,17 +1,24 @@
 #include <thread>			// std::this_thread...
 #include <chrono>			// std::chrono...
 #include <cstdint>			// uint32_t...
+#include <string>			// std::string...
+#include <vector>			// std::vector...
 #include <bclx/bclx.hpp>		// BCL::init...
-#include "../inc/stack.h"		// dds::stack...
+#include "../inc/stack_factory.h"	// dds::make_stack...
 
 using namespace dds;
-using namespace dds::ts;
 
-int main()
+// usage: producer_consumer [stack,...] [memory,...] [batch,...]
+//	batch:	# values an even unit pushes with one push_bulk and an odd unit pops
+//		with one pop_bulk, 1 for single pushes and pops (default)
+// e.g. producer_consumer ts,ebs3,shs hp,nbr runs every stack with every memory
+// manager, and producer_consumer ts,ebs3 hp 1,16 compares single and bulk ops
+int main(int argc, char *argv[])
 {
         uint32_t 	i;
 	uint32_t	value;
 	uint64_t	num_ops;
+	std::vector<uint32_t>	values;
 	double		elapsed_time,
 			total_time;
 	bclx::timer	tim;
@@ -24,103 +31,174 @@ int main()
 		return -1;
 	}
 
-        stack<uint32_t> myStack(TOTAL_OPS / 2);
-	num_ops = TOTAL_OPS / BCL::nprocs();
+	std::vector<std::string>	variants = bclx::split(argc > 1 ? argv[1] : "ts"),
+					mem_names = bclx::split(argc > 2 ? argv[2] : "");
+	std::vector<uint64_t>		batches = bclx::split_num(argc > 3 ? argv[3] : "1");
 
-	tim.start();	// start the timer
-
-	if (BCL::rank() % 2 == 0)
+	for (const std::string &variant : variants)
+	for (const std::string &mem_name : mem_names)
+	for (const uint64_t &batch : batches)
 	{
-		for (i = 0; i < num_ops; ++i)
+		// tracing
+		#ifdef	TRACING
+			succ_cs = fail_cs = succ_ea = fail_ea = elem_rc = elem_ru = elem_cs = elem_ea = 0;
+			fail_time = 0;
+			mstats = mem_stats();
+		#endif
+
+		stack_name = mem_manager = "";
+		std::unique_ptr<stack<uint32_t>> myStack = make_stack<uint32_t>(variant, mem_name, TOTAL_OPS / 2);
+		if (myStack == nullptr)
+			continue;
+		num_ops = TOTAL_OPS / BCL::nprocs();
+		values.resize(batch);
+
+		tim.reset();
+		tim.start();	// start the timer
+
+		if (batch > 1)
 		{
-			// debugging
-			#ifdef DEBUGGING
-               			printf ("[%lu]%u\n", BCL::rank(), i);
-			#endif
-
-			myStack.push(i);
-			std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+			// producers and consumers move bursts of batch values
+			for (i = 0; i < num_ops; i += batch)
+			{
+				if (BCL::rank() % 2 == 0)
+				{
+					for (uint64_t j = 0; j < batch; ++j)
+						values[j] = i + j;
+					myStack->push_bulk(values.data(), batch);
+				}
+				else // if (BCL::rank() % 2 != 0)
+					myStack->pop_bulk(values.data(), batch);
+				std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+			}
 		}
-	}
-	else // if (BCL::rank() % 2 != 0)
-		for (i = 0; i < num_ops; ++i)
+		else if (BCL::rank() % 2 == 0)
 		{
-                        // debugging
-			#ifdef DEBUGGING
-                        	printf ("[%lu]%u\n", BCL::rank(), i);
-			#endif
-
-			myStack.pop(value);
-			std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+			for (i = 0; i < num_ops; ++i)
+			{
+				// debugging
+				#ifdef DEBUGGING
+	               			printf ("[%lu]%u\n", BCL::rank(), i);
+				#endif
+
+				myStack->push(i);
+				std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+			}
 		}
+		else // if (BCL::rank() % 2 != 0)
+			for (i = 0; i < num_ops; ++i)
+			{
+	                        // debugging
+				#ifdef DEBUGGING
+	                        	printf ("[%lu]%u\n", BCL::rank(), i);
+				#endif
 
-	tim.stop();	// stop the timer
+				myStack->pop(value);
+				std::this_thread::sleep_for(std::chrono::microseconds(WORKLOAD));
+			}
 
-	elapsed_time = tim.get() - ((double) num_ops * WORKLOAD) / 1000000;
+		tim.stop();	// stop the timer
 
-	total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
-	if (BCL::rank() == MASTER_UNIT)
-	{
-		printf("*********************************************************\n");
-		printf("*\tBENCHMARK\t:\tProducer-consumer\t*\n");
-		printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
-		printf("*\tNUM_OPS\t\t:\t%lu (ops/unit)\t\t*\n", num_ops);
-		printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
-		printf("*\tSTACK\t\t:\t%s\t\t\t*\n", stack_name.c_str());
-		printf("*\tMEMORY\t\t:\t%s\t\t\t*\n", mem_manager.c_str());
-		printf("*\tEXEC_TIME\t:\t%f (s)\t\t*\n", total_time);
-		printf("*\tTHROUGHPUT\t:\t%f (ops/s)\t*\n", TOTAL_OPS / total_time);
-                printf("*********************************************************\n");
-	}
+		elapsed_time = tim.get() - ((double) ((batch > 1) ? (num_ops + batch - 1) / batch : num_ops) * WORKLOAD) / 1000000;
 
-	//tracing
-	#ifdef  TRACING
-		uint64_t	node_elem_ru,
-				node_elem_rc,
-				node_succ_cs,
-				node_fail_cs,
-				node_succ_ea,
-				node_fail_ea;
-		double		node_elapsed_time,
-				node_fail_time;
-		bclx::topology	topo;
-
-		if (topo.node_num == 1)
-			printf("[Proc %lu]%f (s), %f (s), %lu, %lu, %lu, %lu, %lu, %lu\n",
-					BCL::rank(), elapsed_time, fail_time,
-					succ_cs, fail_cs,
-					succ_ea, fail_ea,
-					elem_rc, elem_ru);
-
-		MPI_Reduce(&elem_ru, &node_elem_ru, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&elem_rc, &node_elem_rc, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&succ_cs, &node_succ_cs, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&fail_cs, &node_fail_cs, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&succ_ea, &node_succ_ea, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&fail_ea, &node_fail_ea, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&elapsed_time, &node_elapsed_time, 1, MPI_DOUBLE, MPI_MAX, MASTER_UNIT, topo.nodeComm);
-		MPI_Reduce(&fail_time, &node_fail_time, 1, MPI_DOUBLE, MPI_MAX, MASTER_UNIT, topo.nodeComm);
-		if (topo.rank == MASTER_UNIT)
-			printf("[Node %d]%f (s), %f (s), %lu, %lu, %lu, %lu, %lu, %lu\n",
-					topo.node_id, node_elapsed_time, node_fail_time,
-					node_succ_cs, node_fail_cs,
-					node_succ_ea, node_fail_ea,
-					node_elem_rc, node_elem_ru);
-		if (topo.node_num > 1)
+		total_time = bclx::reduce(elapsed_time, MASTER_UNIT, BCL::max<double>{});
+		if (BCL::rank() == MASTER_UNIT)
 		{
-			uint64_t total_elem_ru = bclx::reduce(elem_ru, MASTER_UNIT, BCL::sum<uint64_t>{});
-			uint64_t total_elem_rc = bclx::reduce(elem_rc, MASTER_UNIT, BCL::sum<uint64_t>{});
-			uint64_t total_succ_cs = bclx::reduce(succ_cs, MASTER_UNIT, BCL::sum<uint64_t>{});
-			uint64_t total_fail_cs = bclx::reduce(fail_cs, MASTER_UNIT, BCL::sum<uint64_t>{});
-			uint64_t total_succ_ea = bclx::reduce(succ_ea, MASTER_UNIT, BCL::sum<uint64_t>{});
-			uint64_t total_fail_ea = bclx::reduce(fail_ea, MASTER_UNIT, BCL::sum<uint64_t>{});
-			if (BCL::rank() == MASTER_UNIT)
-				printf("[TOTAL]%lu, %lu, %lu, %lu, %lu, %lu\n",
-						total_succ_cs, total_fail_cs,
-						total_succ_ea, total_fail_ea,
-						total_elem_rc, total_elem_ru);
+			printf("*********************************************************\n");
+			printf("*\tBENCHMARK\t:\tProducer-consumer\t*\n");
+			printf("*\tNUM_UNITS\t:\t%lu\t\t\t*\n", BCL::nprocs());
+			printf("*\tNUM_OPS\t\t:\t%lu (ops/unit)\t\t*\n", num_ops);
+			printf("*\tWORKLOAD\t:\t%u (us)\t\t\t*\n", WORKLOAD);
+			printf("*\tSTACK\t\t:\t%s\t\t\t*\n", stack_name.c_str());
+			printf("*\tMEMORY\t\t:\t%s\t\t\t*\n", mem_manager.c_str());
+			printf("*\tBATCH\t\t:\t%lu\t\t\t*\n", batch);
+			printf("*\tEXEC_TIME\t:\t%f (s)\t\t*\n", total_time);
+			printf("*\tTHROUGHPUT\t:\t%f (ops/s)\t*\n", TOTAL_OPS / total_time);
+	                printf("*********************************************************\n");
 		}
-	#endif
+
+		//tracing
+		#ifdef  TRACING
+			uint64_t	node_elem_ru,
+					node_elem_rc,
+					node_succ_cs,
+					node_fail_cs,
+					node_succ_ea,
+					node_fail_ea;
+			double		node_elapsed_time,
+					node_fail_time;
+			bclx::topology	topo;
+
+			if (topo.node_num == 1)
+				printf("[Proc %lu]%f (s), %f (s), %lu, %lu, %lu, %lu, %lu, %lu\n",
+						BCL::rank(), elapsed_time, fail_time,
+						succ_cs, fail_cs,
+						succ_ea, fail_ea,
+						elem_rc, elem_ru);
+
+			MPI_Reduce(&elem_ru, &node_elem_ru, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&elem_rc, &node_elem_rc, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&succ_cs, &node_succ_cs, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&fail_cs, &node_fail_cs, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&succ_ea, &node_succ_ea, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&fail_ea, &node_fail_ea, 1, MPI_UINT64_T, MPI_SUM, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&elapsed_time, &node_elapsed_time, 1, MPI_DOUBLE, MPI_MAX, MASTER_UNIT, topo.nodeComm);
+			MPI_Reduce(&fail_time, &node_fail_time, 1, MPI_DOUBLE, MPI_MAX, MASTER_UNIT, topo.nodeComm);
+			if (topo.rank == MASTER_UNIT)
+				printf("[Node %d]%f (s), %f (s), %lu, %lu, %lu, %lu, %lu, %lu\n",
+						topo.node_id, node_elapsed_time, node_fail_time,
+						node_succ_cs, node_fail_cs,
+						node_succ_ea, node_fail_ea,
+						node_elem_rc, node_elem_ru);
+			if (topo.node_num > 1)
+			{
+				uint64_t total_elem_ru = bclx::reduce(elem_ru, MASTER_UNIT, BCL::sum<uint64_t>{});
+				uint64_t total_elem_rc = bclx::reduce(elem_rc, MASTER_UNIT, BCL::sum<uint64_t>{});
+				uint64_t total_succ_cs = bclx::reduce(succ_cs, MASTER_UNIT, BCL::sum<uint64_t>{});
+				uint64_t total_fail_cs = bclx::reduce(fail_cs, MASTER_UNIT, BCL::sum<uint64_t>{});
+				uint64_t total_succ_ea = bclx::reduce(succ_ea, MASTER_UNIT, BCL::sum<uint64_t>{});
+				uint64_t total_fail_ea = bclx::reduce(fail_ea, MASTER_UNIT, BCL::sum<uint64_t>{});
+				if (BCL::rank() == MASTER_UNIT)
+					printf("[TOTAL]%lu, %lu, %lu, %lu, %lu, %lu\n",
+							total_succ_cs, total_fail_cs,
+							total_succ_ea, total_fail_ea,
+							total_elem_rc, total_elem_ru);
+			}
+
+			// how the values went from producers to consumers (an elem counts once as
+			// it is pushed and once as it is popped)
+			uint64_t	total_moved = bclx::reduce(elem_cs, MASTER_UNIT, BCL::sum<uint64_t>{}),
+					total_eliminated = bclx::reduce(elem_ea, MASTER_UNIT, BCL::sum<uint64_t>{}),
+					total_ops = bclx::reduce(succ_cs, MASTER_UNIT, BCL::sum<uint64_t>{}),
+					total_retries = bclx::reduce(fail_cs, MASTER_UNIT, BCL::sum<uint64_t>{});
+			if (BCL::rank() == MASTER_UNIT)
+				printf("[Transfers]%lu elems through top in %lu ops (%lu retries), %lu elems eliminated\n",
+						total_moved, total_ops, total_retries, total_eliminated);
+
+			// reclamation statistics
+			char		label[32];
+			mem_stats	node_mstats = mstats.reduce(topo.nodeComm, MASTER_UNIT);
+			if (topo.node_num == 1)
+			{
+				sprintf(label, "[Proc %lu]", BCL::rank());
+				mstats.print(label);
+			}
+			if (topo.rank == MASTER_UNIT)
+			{
+				sprintf(label, "[Node %d]", topo.node_id);
+				node_mstats.print(label);
+			}
+			if (topo.node_num > 1)
+			{
+				mem_stats total_mstats = mstats.reduce(BCL::comm, MASTER_UNIT);
+				if (BCL::rank() == MASTER_UNIT)
+					total_mstats.print("[TOTAL]");
+			}
+		#endif
+
+		// destroy the stack before creating the next one
+		myStack.reset();
+	}
 
 	BCL::finalize();
 
@@ -4,7 +4,6 @@
 #include "../inc/stack.h"	// dds::ts...
 
 using namespace dds;
-using namespace dds::ts;
 
 int main()
 {
@@ -18,7 +17,7 @@ int main()
 
 	bclx::timer	tim;
 
-        stack<uint32_t> myStack;
+        ts::stack<uint32_t> myStack;
 	num_ops = TOTAL_OPS / BCL::nprocs();
 
 	tim.start();	// start the timer
@@ -104,6 +103,26 @@ int main()
 						total_succ_ea, total_fail_ea,
 						total_elem_rc, total_elem_ru);
 		}
+
+		// reclamation statistics
+		char		label[32];
+		mem_stats	node_mstats = mstats.reduce(topo.nodeComm, MASTER_UNIT);
+		if (topo.node_num == 1)
+		{
+			sprintf(label, "[Proc %lu]", BCL::rank());
+			mstats.print(label);
+		}
+		if (topo.rank == MASTER_UNIT)
+		{
+			sprintf(label, "[Node %d]", topo.node_id);
+			node_mstats.print(label);
+		}
+		if (topo.node_num > 1)
+		{
+			mem_stats total_mstats = mstats.reduce(BCL::comm, MASTER_UNIT);
+			if (BCL::rank() == MASTER_UNIT)
+				total_mstats.print("[TOTAL]");
+		}
         #endif
 
 	BCL::finalize();
@@ -10,12 +10,17 @@ namespace dds
 	/* Configurations */
 	#define	TRACING
 	#define	MEM_BL3
+	//#define	MEM_HELP
 	//#define	DEBUGGING
+	//#define	ELEM_PADDED	// start every elem of a memory pool on its own cache line
 
 	const uint64_t	TOTAL_OPS	=	exp2l(15);
 	const uint32_t	WORKLOAD	=	1;		//us
 	const uint32_t	TSS_INTERVAL	=	1;		//us
+	const uint32_t	NUM_SHARDS	=	0;		// # shards of the sharded stack (0: one per unit)
+	const uint32_t	ELIM_BATCH	=	16;		// max # values an elimination slot carries
 	const uint32_t  MASTER_UNIT     =       0;
+	const uint64_t	WM_FREE_LOW	=	exp2l(6);	// low watermark of free elems
 
         /* Constants */
 	const bool	EMPTY		= 	false;
@@ -38,6 +43,8 @@ namespace dds
 		double		fail_time	= 0;
 		uint64_t	elem_rc		= 0;
 		uint64_t	elem_ru		= 0;
+		uint64_t	elem_cs		= 0;	// # elems moved by a successful CAS on top
+		uint64_t	elem_ea		= 0;	// # elems handed over on an elimination array
 	#endif
 
 } /* namespace dds */
@@ -21,6 +21,14 @@
 
 //#include "stack_eb2_na.h"		// Node-Aware Elimination-Backoff Stack 2
 
+//#include "stack_eb3.h"			// Elimination-Backoff Stack 3 using an Adaptive Elimination Array
+
+//#include "stack_fc.h"			// Flat-Combining Stack
+
+//#include "stack_wf.h"			// Wait-Free Stack using Announcement and Helping
+
+//#include "stack_sharded.h"		// Node-Sharded Relaxed Stack with Work Stealing
+
 //#include "stack_ts_stutter.h"		// Time-Stamped Stack using TS-interval&stutter
 
 //#include "stack_ts_atomic.h"		// Time-Stamped Stack using TS-interval&atomic
@@ -29,4 +37,6 @@
 
 //#include "stack_ts_cas.h"		// Time-Stamped Stack using TS-interval&cas
 
+//#include "stack_ts_pool.h"		// Time-Stamped Stack using per-unit SP pools
+
 #endif /* STACK_H */
@@ -0,0 +1,879 @@
+#ifndef STACK_EB3_H
+#define STACK_EB3_H
+
+#include <random>			// std::mt19937...
+#include <vector>			// std::vector...
+#include <algorithm>			// std::min...
+#include <bclx/core/util/backoff.hpp>	// backoff::backoff...
+
+namespace dds
+{
+
+namespace ebs3
+{
+
+/* Macros */
+#ifdef		MEM_HP
+	using namespace hp;
+#elif defined 	MEM_HE
+	using namespace he;
+#elif defined	MEM_IBR
+	using namespace ibr;
+#elif defined	MEM_DANG3
+	using namespace dang3;
+#elif defined	MEM_NBR
+	using namespace nbr;
+#elif defined	MEM_BL3
+	using namespace bl3;
+#else	// No Memory Reclamation
+	using namespace nmr;
+#endif
+
+/* Datatypes */
+template<typename T>
+struct elem
+{
+        gptr<elem<T>>   next;
+        T               value;
+};
+
+enum op_type : uint64_t
+{
+	PUSH	= 1,
+	POP	= 2
+};
+
+template<typename T>
+class elim_array
+{
+public:
+	elim_array();				// collective
+	~elim_array();				// collective
+	bool exchange(const op_type &op,	// non-collective: try to meet a partner of the opposite op
+			gptr<elem<T>> &e);
+	uint64_t give(const T *values,		// non-collective: try to hand the top of a batch to a popper
+			const uint64_t &n);
+	uint64_t take(T *values,		// non-collective: try to take a batch from a pusher
+			const uint64_t &n);
+
+private:
+	// a slot is a single word: EMPTY, an offer (an elem or the rank of a waiting
+	// popper, tagged with the op) or DONE (the exchanged elem, tagged DONE)
+	const uint64_t		EMPTY		= 0;
+	const uint64_t		DONE		= 3;
+	const uint64_t		TAG_MASK	= 3;
+	const uint32_t		PATIENCE	= 16;	// be # polls of an offer before withdrawing it
+	const uint32_t		ADAPT_COUNT	= 8;	// be # consecutive misses before resizing
+
+	// a batch slot is a single word: EMPTY or the rank of the waiting unit, a
+	// count and a tag (an offer of n values, CLAIMED by a partner moving the
+	// values, or DONE with the count that has been moved)
+	const uint64_t		CLAIMED		= 4;
+	const uint64_t		BATCH_MASK	= 7;
+	const uint32_t		COUNT_SHIFT	= 3;
+
+	gptr<uint64_t>		slots;		// be the elimination slots of the compute node (hosted by its first unit)
+	gptr<uint64_t>		batches;	// be the batch elimination slots of the compute node
+	gptr<T>			box;		// be the values of the batch offered by (or to) each unit
+	uint32_t		width_max;	// be # slots of each compute node
+	uint32_t		width;		// be # slots the calling unit currently spreads over
+	uint32_t		misses;		// be # consecutive offers that found no partner
+	uint32_t		collisions;	// be # consecutive attempts that found a busy slot
+	std::mt19937		gen;		// generate slot indices
+
+	uint64_t encode(const gptr<elem<T>> &e, const uint64_t &tag) const;
+	gptr<elem<T>> decode(const uint64_t &word) const;
+	uint64_t encode_batch(const uint64_t &rank, const uint64_t &count, const uint64_t &tag) const;
+	uint64_t exchange_bulk(const op_type &op, const T *src, T *dst, const uint64_t &n);
+	void adapt(const bool &found, const bool &busy);
+};
+
+template<typename T, template<typename> class M = memory>
+class stack
+{
+public:
+	M<elem<T>>		mem;	// manage global memory
+
+	stack();			// collective
+	stack(const uint64_t &num);	// collective
+	~stack();			// collective
+	bool push(const T &value);	// non-collective
+	bool pop(T &value);		// non-collective
+	bool push_bulk(const T *values,	// non-collective: push n values, values[n - 1] ending on top
+			const uint64_t &n);
+	uint64_t pop_bulk(T *values,	// non-collective: pop up to n values, top first
+			const uint64_t &n);
+	void print();			// collective
+
+private:
+	const gptr<elem<T>> 	NULL_PTR = nullptr; 	// be a null constant
+
+        gptr<gptr<elem<T>>>	top;	// point to global address of the top
+	elim_array<T>		elim;	// eliminate concurrent pushes and pops
+
+	bool push_fill(const T &value);
+};
+
+} /* namespace ebs3 */
+
+} /* namespace dds */
+
+template<typename T>
+dds::ebs3::elim_array<T>::elim_array()
+{
+	const topology	&topo = topology::shared();
+	uint32_t	size = topo.size;
+
+	// the partitions are symmetric, so that every unit can address that of its node
+	MPI_Allreduce(&size, &width_max, 1, MPI_UINT32_T, MPI_MAX, BCL::comm);
+	width_max = std::max(width_max / 2, uint32_t(1));
+	slots = BCL::alloc<uint64_t>(width_max);
+	batches = BCL::alloc<uint64_t>(width_max);
+	box = BCL::alloc<T>(ELIM_BATCH);
+	for (uint32_t i = 0; i < width_max; ++i)
+	{
+		bclx::store(EMPTY, slots + i);
+		bclx::store(EMPTY, batches + i);
+	}
+	slots.rank = batches.rank = topo.table[0];
+
+	// an offer packs an elem offset into the lower 32 bits of a word
+	if (BCL::shared_segment_size > (uint64_t(1) << 32))
+		printf("[%lu]ERROR: elim_array.elim_array\n", BCL::rank());
+
+	width = 1;
+	misses = collisions = 0;
+	gen.seed(BCL::rank());
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+dds::ebs3::elim_array<T>::~elim_array()
+{
+	slots.rank = batches.rank = BCL::rank();
+	BCL::dealloc<T>(box);
+	BCL::dealloc<uint64_t>(batches);
+	BCL::dealloc<uint64_t>(slots);
+}
+
+template<typename T>
+bool dds::ebs3::elim_array<T>::exchange(const op_type &op, gptr<elem<T>> &e)
+{
+	gptr<uint64_t>	slot = slots + std::uniform_int_distribution<uint32_t>(0, width - 1)(gen);
+	uint64_t	offer = (op == PUSH) ? encode(e, PUSH) : encode({BCL::rank(), 0}, POP),
+			word;
+
+	// try to leave an offer in an empty slot
+	word = bclx::cas_sync(slot, EMPTY, offer);	// one RMA
+	if (word == EMPTY)
+	{
+		// wait for a partner to turn the offer into DONE
+		for (uint32_t i = 0; i < PATIENCE; ++i)
+		{
+			word = bclx::aget_sync(slot);	// one RMA
+			if ((word & TAG_MASK) == DONE)
+				break;
+		}
+
+		// withdraw the offer, unless a partner has just taken it
+		if ((word & TAG_MASK) != DONE)
+		{
+			word = bclx::cas_sync(slot, offer, EMPTY);	// one RMA
+			if (word == offer)
+			{
+				adapt(false, false);
+				return false;
+			}
+		}
+
+		// the exchange has happened: free the slot for the next pair
+		if (op == POP)
+			e = decode(word);
+		bclx::aput_sync(EMPTY, slot);	// one RMA
+		adapt(true, false);
+		return true;
+	}
+
+	// the slot holds an offer of the opposite op: complete the exchange with one CAS
+	if ((word & TAG_MASK) != op && (word & TAG_MASK) != DONE)
+	{
+		uint64_t done = (op == PUSH) ? encode(e, DONE) : (word & ~TAG_MASK) | DONE;
+		if (bclx::cas_sync(slot, word, done) == word)	// one RMA
+		{
+			if (op == POP)
+				e = decode(word);
+			adapt(true, false);
+			return true;
+		}
+	}
+
+	// the slot is busy with an offer of the same op or an unfinished exchange
+	adapt(false, true);
+	return false;
+}
+
+template<typename T>
+uint64_t dds::ebs3::elim_array<T>::give(const T *values, const uint64_t &n)
+{
+	return exchange_bulk(PUSH, values, nullptr, n);
+}
+
+template<typename T>
+uint64_t dds::ebs3::elim_array<T>::take(T *values, const uint64_t &n)
+{
+	return exchange_bulk(POP, nullptr, values, n);
+}
+
+template<typename T>
+uint64_t dds::ebs3::elim_array<T>::encode(const gptr<elem<T>> &e, const uint64_t &tag) const
+{
+	// elems are at least 4-byte aligned, so the two lowest bits carry the tag
+	static_assert(alignof(elem<T>) >= 4, "elim_array: an elem leaves no room for the tag");
+
+	// debugging
+	#ifdef	DEBUGGING
+		if (e.ptr >= (uint64_t(1) << 32) || (e.ptr & TAG_MASK) != 0)
+			printf("[%lu]ERROR: elim_array.encode\n", BCL::rank());
+	#endif
+
+	return (uint64_t(e.rank) << 32) | e.ptr | tag;
+}
+
+template<typename T>
+bclx::gptr<dds::ebs3::elem<T>> dds::ebs3::elim_array<T>::decode(const uint64_t &word) const
+{
+	return {word >> 32, (word & 0xffffffff) & ~TAG_MASK};
+}
+
+template<typename T>
+uint64_t dds::ebs3::elim_array<T>::encode_batch(const uint64_t &rank, const uint64_t &count, const uint64_t &tag) const
+{
+	return (rank << 32) | (count << COUNT_SHIFT) | tag;
+}
+
+template<typename T>
+uint64_t dds::ebs3::elim_array<T>::exchange_bulk(const op_type &op, const T *src, T *dst, const uint64_t &n)
+{
+	gptr<uint64_t>	slot = batches + std::uniform_int_distribution<uint32_t>(0, width - 1)(gen);
+	uint64_t	offer = encode_batch(BCL::rank(), n, op),
+			word,
+			count;
+
+	// a pusher leaves its batch in its own box, where a popper can get it
+	if (op == PUSH)
+		bclx::store(src, box, n);	// local
+
+	// try to leave an offer in an empty slot
+	word = bclx::cas_sync(slot, EMPTY, offer);	// one RMA
+	if (word == EMPTY)
+	{
+		// wait for a partner to turn the offer into DONE
+		for (uint32_t i = 0; i < PATIENCE; ++i)
+		{
+			word = bclx::aget_sync(slot);	// one RMA
+			if ((word & BATCH_MASK) == DONE)
+				break;
+		}
+
+		// withdraw the offer, unless a partner has just claimed it
+		if ((word & BATCH_MASK) != DONE)
+		{
+			word = bclx::cas_sync(slot, offer, EMPTY);	// one RMA
+			if (word == offer)
+			{
+				adapt(false, false);
+				return 0;
+			}
+
+			// the partner is moving the values: it is two RMAs away from DONE
+			while ((word & BATCH_MASK) != DONE)
+				word = bclx::aget_sync(slot);	// one RMA
+		}
+
+		// a popper finds the top of the batch at the end of its box
+		count = (word & 0xffffffff) >> COUNT_SHIFT;
+		if (op == POP)
+		{
+			bclx::load(box, dst, count);	// local
+			std::reverse(dst, dst + count);
+		}
+
+		// free the slot for the next pair
+		bclx::aput_sync(EMPTY, slot);	// one RMA
+		adapt(true, false);
+		return count;
+	}
+
+	// the slot holds an offer of the opposite op: claim it, so that no other
+	// unit touches the box of the waiting unit while the values are moved
+	if ((word & BATCH_MASK) != op && (word & BATCH_MASK) != DONE && (word & BATCH_MASK) != CLAIMED)
+	{
+		uint64_t	rank = word >> 32,
+				offered = (word & 0xffffffff) >> COUNT_SHIFT;
+
+		if (bclx::cas_sync(slot, word, encode_batch(rank, offered, CLAIMED)) == word)	// one RMA
+		{
+			// move the whole batch with one RMA, the top of the batch first
+			count = std::min(n, offered);
+			if (op == PUSH)
+				bclx::rput_sync(src + n - count, gptr<T>{rank, box.ptr}, count);	// one RMA
+			else // if (op == POP)
+			{
+				bclx::rget_sync(gptr<T>{rank, box.ptr} + (offered - count), dst, count);	// one RMA
+				std::reverse(dst, dst + count);
+			}
+			bclx::aput_sync(encode_batch(rank, count, DONE), slot);	// one RMA
+
+			adapt(true, false);
+			return count;
+		}
+	}
+
+	// the slot is busy with an offer of the same op or an unfinished exchange
+	adapt(false, true);
+	return 0;
+}
+
+template<typename T>
+void dds::ebs3::elim_array<T>::adapt(const bool &found, const bool &busy)
+{
+	// a partner was met: keep the current width
+	if (found)
+	{
+		misses = collisions = 0;
+		return;
+	}
+
+	// offers keep timing out: concentrate them on fewer slots
+	if (!busy && ++misses >= ADAPT_COUNT)
+	{
+		width = std::max(width / 2, uint32_t(1));
+		misses = 0;
+	}
+
+	// slots keep being busy: spread the attempts over more slots
+	else if (busy && ++collisions >= ADAPT_COUNT)
+	{
+		width = std::min(width * 2, width_max);
+		collisions = 0;
+	}
+}
+
+template<typename T, template<typename> class M>
+dds::ebs3::stack<T, M>::stack()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	top = BCL::alloc<gptr<elem<T>>>(1);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		bclx::store(NULL_PTR, top);
+		stack_name = "EBS3";
+	}
+	else
+		top.rank = MASTER_UNIT;
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+dds::ebs3::stack<T, M>::stack(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	top = BCL::alloc<gptr<elem<T>>>(1);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		bclx::store(NULL_PTR, top);
+		stack_name = "EBS3";
+
+		for (uint64_t i = 0; i < num; ++i)
+			push_fill(i);
+	}
+	else
+		top.rank = MASTER_UNIT;
+
+        // synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+dds::ebs3::stack<T, M>::~stack()
+{
+	if (BCL::rank() != MASTER_UNIT)
+		top.rank = BCL::rank();
+	BCL::dealloc<gptr<elem<T>>>(top);
+}
+
+template<typename T, template<typename> class M>
+bool dds::ebs3::stack<T, M>::push(const T &value)
+{
+        gptr<elem<T>> 	oldTopAddr,
+			newTopAddr;
+	backoff		bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef	TRACING
+		double		start;
+	#endif
+
+	// allocate global memory to the new elem
+	newTopAddr = mem.malloc();
+	if (newTopAddr == nullptr)
+	{
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		// out of memory: push back on the caller
+		return false;
+	}
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// get top (from global memory to local memory)
+		oldTopAddr = bclx::aget_sync(top);
+
+		// update new element (global memory)
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({oldTopAddr, value}, newTopAddr);
+		else
+			bclx::rput_sync({oldTopAddr, value}, newTopAddr);
+
+		// update top (global memory)
+		if (bclx::cas_sync(top, oldTopAddr, newTopAddr) == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				++elem_cs;
+			#endif
+
+			return true;
+		}
+
+		// tracing
+		#ifdef	TRACING
+			fail_time += (MPI_Wtime() - start);
+			++fail_cs;
+		#endif
+
+		// back off on the elimination array instead of sleeping
+		if (elim.exchange(PUSH, newTopAddr))
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_ea;
+				++elem_ea;
+			#endif
+
+			return true;
+		}
+
+		// neither top nor a partner: back off before retrying
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_ea;
+		#endif
+	}
+}
+
+template<typename T, template<typename> class M>
+bool dds::ebs3::stack<T, M>::pop(T &value)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	elem<T> 	oldTopVal;
+	gptr<elem<T>> 	oldTopAddr,
+			result;
+	backoff		bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get top
+		oldTopAddr = mem.reserve(top);
+
+		// check if the stack is empty
+		if (oldTopAddr == nullptr)
+		{
+			// end a nonblocking operation
+			mem.op_end();
+
+			printf("[%lu]ERROR: stack.pop\n", BCL::rank());
+			return false;
+		}
+
+		// get node (from global memory to local memory)
+		oldTopVal = bclx::rget_sync(oldTopAddr);
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(top, oldTopAddr))
+				continue;
+
+		// try to update top
+		result = bclx::cas_sync(top, oldTopAddr, oldTopVal.next);
+
+		// unreserve top
+		mem.unreserve(oldTopAddr);
+
+		// check if the update is successful
+		if (result == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				++elem_cs;
+			#endif
+
+			// return the value of the popped elem
+			value = oldTopVal.value;
+
+			// deallocate global memory of the popped elem
+			mem.retire(oldTopAddr);
+
+			// end a nonblocking operation
+			mem.op_end();
+
+			return true;
+		}
+
+		// tracing
+		#ifdef	TRACING
+			fail_time += (MPI_Wtime() - start);
+			++fail_cs;
+		#endif
+
+		// back off on the elimination array instead of sleeping
+		if (elim.exchange(POP, result))
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_ea;
+				++elem_ea;
+			#endif
+
+			// the elem has never been in the stack, so it can be freed at once
+			value = bclx::rget_sync(result).value;
+			mem.free(result);
+
+			// end a nonblocking operation
+			mem.op_end();
+
+			return true;
+		}
+
+		// neither top nor a partner: back off before retrying
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_ea;
+		#endif
+	}
+}
+
+template<typename T, template<typename> class M>
+bool dds::ebs3::stack<T, M>::push_bulk(const T *values, const uint64_t &n)
+{
+	std::vector<gptr<elem<T>>>	newTopAddrs(n);
+	gptr<elem<T>>			oldTopAddr;
+	uint64_t			rest = n,
+					given;
+	backoff				bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef	TRACING
+		double		start;
+	#endif
+
+	if (n == 0)
+		return true;
+
+	// allocate global memory to the new elems
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		newTopAddrs[i] = mem.malloc();
+		if (newTopAddrs[i] == nullptr)
+		{
+			for (uint64_t j = 0; j < i; ++j)
+				mem.free(newTopAddrs[j]);
+
+			// tracing
+			#ifdef	TRACING
+				++fail_cs;
+			#endif
+
+			// out of memory: push back on the caller
+			return false;
+		}
+	}
+
+	// link the new elems into a chain, values[n - 1] being on its top
+	for (uint64_t i = 1; i < n; ++i)
+	{
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({newTopAddrs[i - 1], values[i]}, newTopAddrs[i]);
+		else
+			bclx::rput_sync({newTopAddrs[i - 1], values[i]}, newTopAddrs[i]);
+	}
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// get top (from global memory to local memory)
+		oldTopAddr = bclx::aget_sync(top);
+
+		// hook the bottom of the chain to top (global memory)
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({oldTopAddr, values[0]}, newTopAddrs[0]);
+		else
+			bclx::rput_sync({oldTopAddr, values[0]}, newTopAddrs[0]);
+
+		// splice the rest of the chain with one CAS
+		if (bclx::cas_sync(top, oldTopAddr, newTopAddrs[rest - 1]) == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				elem_cs += rest;
+			#endif
+
+			return true;
+		}
+
+		// tracing
+		#ifdef	TRACING
+			fail_time += (MPI_Wtime() - start);
+			++fail_cs;
+		#endif
+
+		// back off on the elimination array, handing the top of the chain to a waiting popper
+		given = elim.give(values + rest - std::min(rest, uint64_t(ELIM_BATCH)),
+				std::min(rest, uint64_t(ELIM_BATCH)));
+		if (given > 0)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_ea;
+				elem_ea += given;
+			#endif
+
+			// the given elems have never been in the stack, so they can be freed at once
+			for (uint64_t i = rest - given; i < rest; ++i)
+				mem.free(newTopAddrs[i]);
+			rest -= given;
+			if (rest == 0)
+				return true;
+			continue;
+		}
+
+		// neither top nor a partner: back off before retrying
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_ea;
+		#endif
+	}
+}
+
+template<typename T, template<typename> class M>
+uint64_t dds::ebs3::stack<T, M>::pop_bulk(T *values, const uint64_t &n)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	std::vector<gptr<elem<T>>>	oldTopAddrs;
+	elem<T>				topVal;
+	gptr<elem<T>>			oldTopAddr,
+					newTopAddr,
+					result;
+	uint64_t			taken;
+	backoff				bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
+
+	oldTopAddrs.reserve(n);
+	while (n > 0)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get top
+		oldTopAddrs.clear();
+		oldTopAddr = mem.reserve(top);
+
+		// check if the stack is empty
+		if (oldTopAddr == nullptr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			break;
+		}
+
+		// walk down the stack for up to n elems. The elems below top are
+		// not reserved, but they cannot change while top stays unchanged,
+		// so whatever is read here is valid if the CAS succeeds
+		newTopAddr = oldTopAddr;
+		while (oldTopAddrs.size() < n && newTopAddr != nullptr)
+		{
+			topVal = bclx::rget_sync(newTopAddr);
+			values[oldTopAddrs.size()] = topVal.value;
+			oldTopAddrs.push_back(newTopAddr);
+			newTopAddr = topVal.next;
+		}
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(top, oldTopAddr))
+				continue;
+
+		// try to detach the elems with one CAS
+		result = bclx::cas_sync(top, oldTopAddr, newTopAddr);
+
+		// unreserve top
+		mem.unreserve(oldTopAddr);
+
+		// check if the update is successful
+		if (result == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				elem_cs += oldTopAddrs.size();
+			#endif
+
+			break;
+		}
+
+		// tracing
+		#ifdef	TRACING
+			fail_time += (MPI_Wtime() - start);
+			++fail_cs;
+		#endif
+
+		// back off on the elimination array, taking a batch from a waiting pusher
+		taken = elim.take(values, std::min(n, uint64_t(ELIM_BATCH)));
+		if (taken > 0)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_ea;
+				elem_ea += taken;
+			#endif
+
+			// end a nonblocking operation
+			mem.op_end();
+
+			return taken;
+		}
+
+		// neither top nor a partner: back off before retrying
+		bk.delay_dbl();
+
+		// tracing
+		#ifdef	TRACING
+			++fail_ea;
+		#endif
+	}
+
+	// deallocate global memory of the popped elems
+	for (uint64_t i = 0; i < oldTopAddrs.size(); ++i)
+		mem.retire(oldTopAddrs[i]);
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return oldTopAddrs.size();
+}
+
+template<typename T, template<typename> class M>
+void dds::ebs3::stack<T, M>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		gptr<elem<T>>	topAddr;
+		elem<T>		topVal;
+
+		for (topAddr = bclx::load(top); topAddr != nullptr; topAddr = topVal.next)
+		{
+			topVal = bclx::rget_sync(topAddr);
+			printf("value = %d\n", topVal.value);
+			topVal.next.print();
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+bool dds::ebs3::stack<T, M>::push_fill(const T &value)
+{
+	gptr<elem<T>>		oldTopAddr,
+				newTopAddr;
+
+	// allocate global memory to the new elem
+	newTopAddr = mem.malloc();
+	if (newTopAddr == nullptr)
+	{
+		printf("[%lu]ERROR: stack.push_fill\n", BCL::rank());
+		return false;
+	}
+
+	// get top (from global memory to local memory)
+	oldTopAddr = bclx::load(top);
+
+	// update new element (global memory)
+	if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+		bclx::store({oldTopAddr, value}, newTopAddr);
+	else
+		bclx::rput_sync({oldTopAddr, value}, newTopAddr);
+
+	// update top (global memory)
+	bclx::store(newTopAddr, top);
+
+	return true;
+}
+
+#endif /* STACK_EB3_H */
@@ -0,0 +1,196 @@
+#ifndef STACK_FACTORY_H
+#define STACK_FACTORY_H
+
+#include <string>		// std::string...
+#include <memory>		// std::unique_ptr...
+#include "stack.h"		// Configurations & Global Memory Management
+#include "stack_treiber.h"	// Treiber's Stack
+#include "stack_eb3.h"		// Elimination-Backoff Stack 3
+#include "stack_fc.h"		// Flat-Combining Stack
+#include "stack_sharded.h"	// Node-Sharded Relaxed Stack
+#include "stack_ts_pool.h"	// Time-Stamped Stack using per-unit SP pools
+#include "stack_wf.h"		// Wait-Free Stack
+
+namespace dds
+{
+
+/* Datatypes */
+// the interface every stack variant provides: a collective constructor that
+// takes # initial elems, non-collective push/pop and a collective print. The
+// bulk ops push n values (values[n - 1] ending on top) or pop up to n values
+// (top first), one at a time unless the variant has its own bulk ops
+template<typename T>
+class stack
+{
+public:
+	virtual ~stack() {}				// collective
+	virtual bool push(const T &value) = 0;		// non-collective
+	virtual bool pop(T &value) = 0;			// non-collective
+	virtual bool push_bulk(const T *values,		// non-collective
+			const uint64_t &n);
+	virtual uint64_t pop_bulk(T *values,		// non-collective
+			const uint64_t &n);
+	virtual void print() = 0;			// collective
+};
+
+// whether a stack variant splices a whole batch with one CAS on top
+template<typename S>
+struct stack_traits
+{
+	static const bool	BULK	= false;
+};
+
+template<typename T, template<typename> class M>
+struct stack_traits<ts::stack<T, M>>
+{
+	static const bool	BULK	= true;
+};
+
+template<typename T, template<typename> class M>
+struct stack_traits<ebs3::stack<T, M>>
+{
+	static const bool	BULK	= true;
+};
+
+template<typename T, typename S>
+class stack_adapter : public stack<T>
+{
+public:
+	stack_adapter(const uint64_t &num);		// collective
+	bool push(const T &value) override;		// non-collective
+	bool pop(T &value) override;			// non-collective
+	bool push_bulk(const T *values,			// non-collective
+			const uint64_t &n) override;
+	uint64_t pop_bulk(T *values,			// non-collective
+			const uint64_t &n) override;
+	void print() override;				// collective
+
+private:
+	S	s;	// be the wrapped stack variant
+};
+
+/* Functions */
+template<typename T>
+std::unique_ptr<stack<T>> make_stack(const std::string &variant,	// collective: create a stack variant
+		const std::string &mem_name,				// using a memory manager ("" for the default one, or for fcs and tsp)
+		const uint64_t &num);					// with # initial elems
+
+template<typename T, template<typename> class M>
+std::unique_ptr<stack<T>> make_stack_with(const std::string &variant,
+		const uint64_t &num);
+
+} /* namespace dds */
+
+template<typename T>
+bool dds::stack<T>::push_bulk(const T *values, const uint64_t &n)
+{
+	for (uint64_t i = 0; i < n; ++i)
+		if (!push(values[i]))
+			return false;
+	return true;
+}
+
+template<typename T>
+uint64_t dds::stack<T>::pop_bulk(T *values, const uint64_t &n)
+{
+	uint64_t	i;
+
+	for (i = 0; i < n; ++i)
+		if (!pop(values[i]))
+			break;
+	return i;
+}
+
+template<typename T, typename S>
+dds::stack_adapter<T, S>::stack_adapter(const uint64_t &num) : s(num) {}
+
+template<typename T, typename S>
+bool dds::stack_adapter<T, S>::push(const T &value)
+{
+	return s.push(value);
+}
+
+template<typename T, typename S>
+bool dds::stack_adapter<T, S>::pop(T &value)
+{
+	return s.pop(value);
+}
+
+template<typename T, typename S>
+bool dds::stack_adapter<T, S>::push_bulk(const T *values, const uint64_t &n)
+{
+	if constexpr (stack_traits<S>::BULK)
+		return s.push_bulk(values, n);
+	else
+		return stack<T>::push_bulk(values, n);
+}
+
+template<typename T, typename S>
+uint64_t dds::stack_adapter<T, S>::pop_bulk(T *values, const uint64_t &n)
+{
+	if constexpr (stack_traits<S>::BULK)
+		return s.pop_bulk(values, n);
+	else
+		return stack<T>::pop_bulk(values, n);
+}
+
+template<typename T, typename S>
+void dds::stack_adapter<T, S>::print()
+{
+	s.print();
+}
+
+template<typename T>
+std::unique_ptr<dds::stack<T>> dds::make_stack(const std::string &variant, const std::string &mem_name, const uint64_t &num)
+{
+	// the stacks that manage no global memory of their own take no memory manager
+	if (variant == "fcs" || variant == "tsp")
+	{
+		if (mem_name != "")
+		{
+			printf("[%lu]ERROR: make_stack: %s takes no memory manager\n", BCL::rank(), variant.c_str());
+			return nullptr;
+		}
+		if (variant == "fcs")
+			return std::unique_ptr<stack<T>>(new stack_adapter<T, fcs::stack<T>>(num));
+		return std::unique_ptr<stack<T>>(new stack_adapter<T, tsp::stack<T>>(num));
+	}
+
+	if (mem_name == "")
+		return make_stack_with<T, ts::memory>(variant, num);
+	if (mem_name == "nmr")
+		return make_stack_with<T, nmr::memory>(variant, num);
+	if (mem_name == "hp")
+		return make_stack_with<T, hp::memory>(variant, num);
+	if (mem_name == "he")
+		return make_stack_with<T, he::memory>(variant, num);
+	if (mem_name == "ibr")
+		return make_stack_with<T, ibr::memory>(variant, num);
+	if (mem_name == "nbr")
+		return make_stack_with<T, nbr::memory>(variant, num);
+	if (mem_name == "dang3")
+		return make_stack_with<T, dang3::memory>(variant, num);
+	if (mem_name == "bl3")
+		return make_stack_with<T, bl3::memory>(variant, num);
+
+	printf("[%lu]ERROR: make_stack: unknown memory manager %s\n", BCL::rank(), mem_name.c_str());
+	return nullptr;
+}
+
+template<typename T, template<typename> class M>
+std::unique_ptr<dds::stack<T>> dds::make_stack_with(const std::string &variant, const uint64_t &num)
+{
+	if (variant == "ts")
+		return std::unique_ptr<stack<T>>(new stack_adapter<T, ts::stack<T, M>>(num));
+	if (variant == "ebs3")
+		return std::unique_ptr<stack<T>>(new stack_adapter<T, ebs3::stack<T, M>>(num));
+	if (variant == "shs")
+		return std::unique_ptr<stack<T>>(new stack_adapter<T, shs::stack<T, M>>(num));
+	if (variant == "wfs")
+		return std::unique_ptr<stack<T>>(new stack_adapter<T, wfs::stack<T, M>>(num));
+
+	printf("[%lu]ERROR: make_stack: unknown stack %s\n", BCL::rank(), variant.c_str());
+	return nullptr;
+}
+
+#endif /* STACK_FACTORY_H */
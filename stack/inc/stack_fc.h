@@ -0,0 +1,239 @@
+#ifndef STACK_FC_H
+#define STACK_FC_H
+
+#include <vector>			// std::vector...
+#include <algorithm>			// std::min...
+#include "../../lock/inc/lock_fc.h"	// dds::fc::publication...
+
+namespace dds
+{
+
+namespace fcs
+{
+
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
+enum op_type : uint32_t
+{
+	NONE,
+	PUSH,
+	POP
+};
+
+template<typename T>
+using request = fc::request<T>;
+
+template<typename T>
+using response = fc::response<T>;
+
+template<typename T>
+class stack
+{
+public:
+	stack();			// collective
+	stack(const uint64_t &num);	// collective
+	~stack();			// collective
+	bool push(const T &value);	// non-collective
+	bool pop(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	const uint64_t		CAPACITY	= TOTAL_OPS;	// be the max # elems in the stack
+	const uint32_t		PATIENCE	= 16;		// be # polls before a unit far from MASTER_UNIT combines
+
+	fc::publication<T>	pub;		// be the publication array (hosted by MASTER_UNIT)
+	gptr<T>			items;		// be the elems of the stack (hosted by MASTER_UNIT)
+	gptr<uint64_t>		size;		// be # elems in the stack (hosted by MASTER_UNIT)
+	bool			near_master;	// be set if the calling unit shares a compute node with MASTER_UNIT
+
+	void init(const uint64_t &num);
+	bool apply(const uint32_t &op, T &value);
+	void combine(const std::vector<request<T>> &req,
+			std::vector<response<T>> &resp,
+			const std::vector<uint64_t> &pending);
+};
+
+} /* namespace fcs */
+
+} /* namespace dds */
+
+template<typename T>
+dds::fcs::stack<T>::stack()
+{
+	init(0);
+}
+
+template<typename T>
+dds::fcs::stack<T>::stack(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T>
+dds::fcs::stack<T>::~stack()
+{
+	if (BCL::rank() != MASTER_UNIT)
+	{
+		items.rank = BCL::rank();
+		size.rank = BCL::rank();
+	}
+	BCL::dealloc<uint64_t>(size);
+	BCL::dealloc<T>(items);
+}
+
+template<typename T>
+bool dds::fcs::stack<T>::push(const T &value)
+{
+	T temp = value;
+	return apply(PUSH, temp);
+}
+
+template<typename T>
+bool dds::fcs::stack<T>::pop(T &value)
+{
+	if (apply(POP, value))
+		return true;
+
+	printf("[%lu]ERROR: stack.pop\n", BCL::rank());
+	return false;
+}
+
+template<typename T>
+void dds::fcs::stack<T>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		T	*local = items.local();
+
+		for (uint64_t i = bclx::load(size); i > 0; --i)
+			printf("value = %d\n", local[i - 1]);
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+void dds::fcs::stack<T>::init(const uint64_t &num)
+{
+	bclx::topology	topo;
+
+	// synchronize
+	bclx::barrier_sync();
+
+	items = BCL::alloc<T>(CAPACITY);
+	size = BCL::alloc<uint64_t>(1);
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		T	*local = items.local();
+
+		for (uint64_t i = 0; i < num; ++i)
+			local[i] = i;
+		bclx::store(num, size);
+		stack_name = "FCS";
+	}
+	else // if (BCL::rank() != MASTER_UNIT)
+	{
+		items.rank = MASTER_UNIT;
+		size.rank = MASTER_UNIT;
+	}
+	near_master = (topo.node_id == topo.node_id_master);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+bool dds::fcs::stack<T>::apply(const uint32_t &op, T &value)
+{
+	// units near MASTER_UNIT become combiners eagerly, the others
+	// only after waiting PATIENCE polls for a combiner to show up
+	response<T> resp = pub.apply(op, value, near_master ? 0 : PATIENCE,
+			[this](const std::vector<request<T>> &req, std::vector<response<T>> &resp,
+				const std::vector<uint64_t> &pending) { combine(req, resp, pending); });
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	if (op == POP)
+		value = resp.value;
+	return resp.status;
+}
+
+template<typename T>
+void dds::fcs::stack<T>::combine(const std::vector<request<T>> &req, std::vector<response<T>> &resp, const std::vector<uint64_t> &pending)
+{
+	std::vector<uint64_t>		pushes,
+					pops;
+	std::vector<T>			vals;
+	uint64_t			num,
+					num_old;
+
+	for (uint64_t i : pending)
+		if (req[i].op == PUSH)
+			pushes.push_back(i);
+		else // if (req[i].op == POP)
+			pops.push_back(i);
+
+	// eliminate pairs of pushes and pops without touching the stack
+	while (!pushes.empty() && !pops.empty())
+	{
+		uint64_t i = pushes.back(),
+			 j = pops.back();
+		pushes.pop_back();
+		pops.pop_back();
+		resp[i] = {req[i].seq, true, req[i].value};
+		resp[j] = {req[j].seq, true, req[i].value};
+
+		// tracing
+		#ifdef	TRACING
+			succ_ea += 2;
+		#endif
+	}
+
+	num = num_old = bclx::aget_sync(size);	// one RMA
+
+	// apply the remaining pushes in one batch
+	for (uint64_t i : pushes)
+		if (num + vals.size() < CAPACITY)
+		{
+			vals.push_back(req[i].value);
+			resp[i] = {req[i].seq, true, req[i].value};
+		}
+		else // if the stack is full
+			resp[i] = {req[i].seq, false, req[i].value};
+	if (!vals.empty())
+	{
+		bclx::rput_sync(vals.data(), items + num, vals.size());	// one RMA
+		num += vals.size();
+	}
+
+	// apply the remaining pops in one batch
+	if (!pops.empty())
+	{
+		uint64_t k = std::min(uint64_t(pops.size()), num);
+		vals.resize(k);
+		if (k > 0)
+		{
+			bclx::rget_sync(items + (num - k), vals.data(), k);	// one RMA
+			num -= k;
+		}
+		for (uint64_t i = 0; i < pops.size(); ++i)
+			if (i < k)
+				resp[pops[i]] = {req[pops[i]].seq, true, vals[k - 1 - i]};
+			else // if the stack is empty
+				resp[pops[i]] = {req[pops[i]].seq, false, T()};
+	}
+
+	if (num != num_old)
+		bclx::aput_sync(num, size);	// one RMA
+}
+
+#endif /* STACK_FC_H */
@@ -0,0 +1,357 @@
+#ifndef STACK_SHARDED_H
+#define STACK_SHARDED_H
+
+#include <vector>			// std::vector...
+#include <bclx/core/util/backoff.hpp>	// backoff::backoff...
+
+namespace dds
+{
+
+namespace shs
+{
+
+/* Macros */
+#ifdef		MEM_HP
+	using namespace hp;
+#elif defined 	MEM_HE
+	using namespace he;
+#elif defined	MEM_IBR
+	using namespace ibr;
+#elif defined	MEM_DANG3
+	using namespace dang3;
+#elif defined	MEM_NBR
+	using namespace nbr;
+#elif defined	MEM_BL3
+	using namespace bl3;
+#else	// No Memory Reclamation
+	using namespace nmr;
+#endif
+
+/* Datatypes */
+template<typename T>
+struct elem
+{
+        gptr<elem<T>>   next;
+        T               value;
+};
+
+template<typename T, template<typename> class M = memory>
+class stack
+{
+public:
+	M<elem<T>>		mem;	// manage global memory
+
+	stack();			// collective
+	stack(const uint64_t &num);	// collective
+	~stack();			// collective
+	bool push(const T &value);	// non-collective
+	bool pop(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	const gptr<elem<T>> 	NULL_PTR = nullptr; 	// be a null constant
+
+	uint32_t		shards;		// be # shards (1: strict LIFO, nprocs: one per unit)
+	uint32_t		width;		// be # units sharing a shard
+	uint32_t		shard_local;	// be the shard of the calling unit
+	std::vector<uint32_t>	victims;	// be the other shards, those on the same compute node first
+        gptr<gptr<elem<T>>>	top;		// point to global address of the top of each shard
+
+	void init(const uint64_t &num);
+	gptr<gptr<elem<T>>> top_of(const uint32_t &shard) const;
+	bool pop_shard(const gptr<gptr<elem<T>>> &top_shard, T &value);
+	bool push_fill(const T &value);
+};
+
+} /* namespace shs */
+
+} /* namespace dds */
+
+template<typename T, template<typename> class M>
+dds::shs::stack<T, M>::stack()
+{
+	init(0);
+}
+
+template<typename T, template<typename> class M>
+dds::shs::stack<T, M>::stack(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T, template<typename> class M>
+dds::shs::stack<T, M>::~stack()
+{
+	top.rank = BCL::rank();
+	BCL::dealloc<gptr<elem<T>>>(top);
+}
+
+template<typename T, template<typename> class M>
+bool dds::shs::stack<T, M>::push(const T &value)
+{
+        gptr<gptr<elem<T>>>	top_shard = top_of(shard_local);
+        gptr<elem<T>> 		oldTopAddr,
+				newTopAddr;
+	backoff			bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef	TRACING
+		double		start;
+	#endif
+
+	// allocate global memory to the new elem
+	newTopAddr = mem.malloc();
+	if (newTopAddr == nullptr)
+	{
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		// out of memory: push back on the caller
+		return false;
+	}
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// get the top of the local shard (from global memory to local memory)
+		oldTopAddr = bclx::aget_sync(top_shard);
+
+		// update new element (global memory)
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({oldTopAddr, value}, newTopAddr);
+		else
+			bclx::rput_sync({oldTopAddr, value}, newTopAddr);
+
+		// update the top of the local shard (global memory)
+		if (bclx::cas_sync(top_shard, oldTopAddr, newTopAddr) == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			return true;
+		}
+		else // if (bclx::cas_sync(top_shard, oldTopAddr, newTopAddr) != oldTopAddr)
+		{
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
+		}
+	}
+}
+
+template<typename T, template<typename> class M>
+bool dds::shs::stack<T, M>::pop(T &value)
+{
+	// try the local shard first
+	if (pop_shard(top_of(shard_local), value))
+		return true;
+
+	// the local shard is empty: steal from the other shards, nearest first
+	for (uint32_t i = 0; i < victims.size(); ++i)
+		if (pop_shard(top_of(victims[i]), value))
+			return true;
+
+	printf("[%lu]ERROR: stack.pop\n", BCL::rank());
+	return false;
+}
+
+template<typename T, template<typename> class M>
+void dds::shs::stack<T, M>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		gptr<elem<T>>	topAddr;
+		elem<T>		topVal;
+
+		for (uint32_t i = 0; i < shards; ++i)
+		{
+			printf("shard = %u\n", i);
+			for (topAddr = bclx::aget_sync(top_of(i)); topAddr != nullptr; topAddr = topVal.next)
+			{
+				topVal = bclx::rget_sync(topAddr);
+				printf("value = %d\n", topVal.value);
+				topVal.next.print();
+			}
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+void dds::shs::stack<T, M>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	shards = (NUM_SHARDS == 0 || NUM_SHARDS > BCL::nprocs()) ? BCL::nprocs() : NUM_SHARDS;
+	width = (BCL::nprocs() + shards - 1) / shards;
+	shards = (BCL::nprocs() + width - 1) / width;
+	shard_local = BCL::rank() / width;
+
+	// order the victims of work stealing by their distance
+	bclx::topology		topo;
+	std::vector<bool>	near(shards, false);
+	for (int i = 0; i < topo.size; ++i)
+		if (topo.table[i] % width == 0)
+			near[topo.table[i] / width] = true;
+	for (uint32_t i = 1; i < shards; ++i)
+		if (near[(shard_local + i) % shards])
+			victims.push_back((shard_local + i) % shards);
+	for (uint32_t i = 1; i < shards; ++i)
+		if (!near[(shard_local + i) % shards])
+			victims.push_back((shard_local + i) % shards);
+
+	// every unit allocates a top, but only the first unit of each shard hosts one
+	top = BCL::alloc<gptr<elem<T>>>(1);
+	bclx::store(NULL_PTR, top);
+	if (BCL::rank() == MASTER_UNIT)
+		stack_name = "SHS";
+
+	// synchronize
+	bclx::barrier_sync();
+
+	// the hosts of the shards share the initial elems
+	if (BCL::rank() % width == 0)
+		for (uint64_t i = shard_local; i < num; i += shards)
+			push_fill(i);
+
+        // synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+bclx::gptr<bclx::gptr<dds::shs::elem<T>>> dds::shs::stack<T, M>::top_of(const uint32_t &shard) const
+{
+	return {shard * width, top.ptr};
+}
+
+template<typename T, template<typename> class M>
+bool dds::shs::stack<T, M>::pop_shard(const gptr<gptr<elem<T>>> &top_shard, T &value)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	elem<T> 	oldTopVal;
+	gptr<elem<T>> 	oldTopAddr,
+			result;
+	backoff		bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get the top of the shard
+		oldTopAddr = mem.reserve(top_shard);
+
+		// check if the shard is empty
+		if (oldTopAddr == nullptr)
+		{
+			// end a nonblocking operation
+			mem.op_end();
+
+			return false;
+		}
+
+		// get node (from global memory to local memory)
+		oldTopVal = bclx::rget_sync(oldTopAddr);
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(top_shard, oldTopAddr))
+				continue;
+
+		// try to update the top of the shard
+		result = bclx::cas_sync(top_shard, oldTopAddr, oldTopVal.next);
+
+		// unreserve the top of the shard
+		mem.unreserve(oldTopAddr);
+
+		// check if the update is successful
+		if (result == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			break;
+		}
+		else // if (result != oldTopAddr)
+		{
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
+		}
+	}
+
+	// return the value of the popped elem
+	value = oldTopVal.value;
+
+	// deallocate global memory of the popped elem
+	mem.retire(oldTopAddr);
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return true;
+}
+
+template<typename T, template<typename> class M>
+bool dds::shs::stack<T, M>::push_fill(const T &value)
+{
+	gptr<elem<T>>		oldTopAddr,
+				newTopAddr;
+
+	// allocate global memory to the new elem
+	newTopAddr = mem.malloc();
+	if (newTopAddr == nullptr)
+	{
+		printf("[%lu]ERROR: stack.push_fill\n", BCL::rank());
+		return false;
+	}
+
+	// get top (from global memory to local memory)
+	oldTopAddr = bclx::load(top);
+
+	// update new element (global memory)
+	if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+		bclx::store({oldTopAddr, value}, newTopAddr);
+	else
+		bclx::rput_sync({oldTopAddr, value}, newTopAddr);
+
+	// update top (global memory)
+	bclx::store(newTopAddr, top);
+
+	return true;
+}
+
+#endif /* STACK_SHARDED_H */
@@ -1,6 +1,8 @@
 #ifndef STACK_TREIBER_H
 #define STACK_TREIBER_H
 
+#include <vector>	// std::vector...
+
 namespace dds
 {
 
@@ -28,6 +30,8 @@ namespace ts
 	using namespace dang3;
 #elif defined	MEM_DANG4
 	using namespace dang4;
+#elif defined	MEM_NBR
+	using namespace nbr;
 #elif defined	MEM_BL
 	using namespace bl;
 #elif defined	MEM_BL2
@@ -46,17 +50,21 @@ struct elem
         T               value;
 };
 
-template<typename T>
+template<typename T, template<typename> class M = memory>
 class stack
 {
 public:
-	memory<elem<T>>		mem;	// manage global memory
+	M<elem<T>>		mem;	// manage global memory
 
 	stack();			// collective
 	stack(const uint64_t &num);	// collective
 	~stack();			// collective
 	bool push(const T &value);	// non-collective
 	bool pop(T &value);		// non-collective
+	bool push_bulk(const T *values,	// non-collective
+			const uint64_t &n);
+	uint64_t pop_bulk(T *values,	// non-collective
+			const uint64_t &n);
 	void print();			// collective
 
 private:
@@ -71,8 +79,8 @@ private:
 
 } /* namespace dds */
 
-template<typename T>
-dds::ts::stack<T>::stack()
+template<typename T, template<typename> class M>
+dds::ts::stack<T, M>::stack()
 {
 	// synchronize
 	bclx::barrier_sync();
@@ -90,8 +98,8 @@ dds::ts::stack<T>::stack()
 	bclx::barrier_sync();
 }
 
-template<typename T>
-dds::ts::stack<T>::stack(const uint64_t &num)
+template<typename T, template<typename> class M>
+dds::ts::stack<T, M>::stack(const uint64_t &num)
 {
 	// synchronize
 	bclx::barrier_sync();
@@ -112,16 +120,16 @@ dds::ts::stack<T>::stack(const uint64_t &num)
 	bclx::barrier_sync();
 }
 
-template<typename T>
-dds::ts::stack<T>::~stack()
+template<typename T, template<typename> class M>
+dds::ts::stack<T, M>::~stack()
 {
 	if (BCL::rank() != MASTER_UNIT)
 		top.rank = BCL::rank();
 	BCL::dealloc<gptr<elem<T>>>(top);
 }
 
-template<typename T>
-bool dds::ts::stack<T>::push(const T &value)
+template<typename T, template<typename> class M>
+bool dds::ts::stack<T, M>::push(const T &value)
 {
         gptr<elem<T>> 	oldTopAddr,
 			newTopAddr;
@@ -141,7 +149,7 @@ bool dds::ts::stack<T>::push(const T &value)
 			++fail_cs;
 		#endif
 
-		printf("[%lu]ERROR: stack.push\n", BCL::rank());
+		// out of memory: push back on the caller
 		return false;
 	}
 
@@ -156,11 +164,10 @@ bool dds::ts::stack<T>::push(const T &value)
 		oldTopAddr = bclx::aget_sync(top);
 
 		// update new element (global memory)
-		#ifdef	MEM_DANG3
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
 			bclx::store({oldTopAddr, value}, newTopAddr);
-		#else
+		else
 			bclx::rput_sync({oldTopAddr, value}, newTopAddr);
-		#endif
 
 		// update top (global memory)
 		if (bclx::cas_sync(top, oldTopAddr, newTopAddr) == oldTopAddr)
@@ -168,6 +175,7 @@ bool dds::ts::stack<T>::push(const T &value)
 			// tracing
 			#ifdef	TRACING
 				++succ_cs;
+				++elem_cs;
 			#endif
 
 			return true;
@@ -185,8 +193,8 @@ bool dds::ts::stack<T>::push(const T &value)
 	}
 }
 
-template<typename T>
-bool dds::ts::stack<T>::pop(T &value)
+template<typename T, template<typename> class M>
+bool dds::ts::stack<T, M>::pop(T &value)
 {
 	// begin a nonblocking operation
 	mem.op_begin();
@@ -229,6 +237,11 @@ bool dds::ts::stack<T>::pop(T &value)
 		// get node (from global memory to local memory)
 		oldTopVal = bclx::rget_sync(oldTopAddr);
 
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(top, oldTopAddr))
+				continue;
+
 		// try to update top
 		result = bclx::cas_sync(top, oldTopAddr, oldTopVal.next);
 		
@@ -241,6 +254,7 @@ bool dds::ts::stack<T>::pop(T &value)
 			// tracing
 			#ifdef	TRACING
 				++succ_cs;
+				++elem_cs;
 			#endif
 
 			break;
@@ -269,8 +283,188 @@ bool dds::ts::stack<T>::pop(T &value)
 	return true;
 }
 
-template<typename T>
-void dds::ts::stack<T>::print()
+template<typename T, template<typename> class M>
+bool dds::ts::stack<T, M>::push_bulk(const T *values, const uint64_t &n)
+{
+	std::vector<gptr<elem<T>>>	newTopAddrs(n);
+	gptr<elem<T>>			oldTopAddr;
+	backoff				bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef	TRACING
+		double		start;
+	#endif
+
+	if (n == 0)
+		return true;
+
+	// allocate global memory to the new elems
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		newTopAddrs[i] = mem.malloc();
+		if (newTopAddrs[i] == nullptr)
+		{
+			for (uint64_t j = 0; j < i; ++j)
+				mem.free(newTopAddrs[j]);
+
+			// tracing
+			#ifdef	TRACING
+				++fail_cs;
+			#endif
+
+			// out of memory: push back on the caller
+			return false;
+		}
+	}
+
+	// link the new elems into a chain, values[n - 1] being on its top
+	for (uint64_t i = 1; i < n; ++i)
+	{
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({newTopAddrs[i - 1], values[i]}, newTopAddrs[i]);
+		else
+			bclx::rput_sync({newTopAddrs[i - 1], values[i]}, newTopAddrs[i]);
+	}
+
+	while (true)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// get top (from global memory to local memory)
+		oldTopAddr = bclx::aget_sync(top);
+
+		// hook the bottom of the chain to top (global memory)
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({oldTopAddr, values[0]}, newTopAddrs[0]);
+		else
+			bclx::rput_sync({oldTopAddr, values[0]}, newTopAddrs[0]);
+
+		// splice the whole chain with one CAS
+		if (bclx::cas_sync(top, oldTopAddr, newTopAddrs[n - 1]) == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				elem_cs += n;
+			#endif
+
+			return true;
+		}
+		else // if (bclx::cas_sync(top, oldTopAddr, newTopAddrs[n - 1]) != oldTopAddr)
+		{
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
+		}
+	}
+}
+
+template<typename T, template<typename> class M>
+uint64_t dds::ts::stack<T, M>::pop_bulk(T *values, const uint64_t &n)
+{
+	// begin a nonblocking operation
+	mem.op_begin();
+
+	std::vector<gptr<elem<T>>>	oldTopAddrs;
+	elem<T>				topVal;
+	gptr<elem<T>>			oldTopAddr,
+					newTopAddr,
+					result;
+	backoff				bk(bk_init, bk_max);
+
+	// tracing
+	#ifdef  TRACING
+		double		start;
+	#endif
+
+	oldTopAddrs.reserve(n);
+	while (n > 0)
+	{
+		// tracing
+		#ifdef	TRACING
+			start = MPI_Wtime();
+		#endif
+
+		// reserve and get top
+		oldTopAddrs.clear();
+		oldTopAddr = mem.reserve(top);
+
+		// check if the stack is empty
+		if (oldTopAddr == nullptr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+			#endif
+
+			break;
+		}
+
+		// walk down the stack for up to n elems. The elems below top are
+		// not reserved, but they cannot change while top stays unchanged,
+		// so whatever is read here is valid if the CAS succeeds
+		newTopAddr = oldTopAddr;
+		while (oldTopAddrs.size() < n && newTopAddr != nullptr)
+		{
+			topVal = bclx::rget_sync(newTopAddr);
+			values[oldTopAddrs.size()] = topVal.value;
+			oldTopAddrs.push_back(newTopAddr);
+			newTopAddr = topVal.next;
+		}
+
+		// enter the write phase, restart if a reclaimer has neutralized us
+		if constexpr (mem_traits<M<elem<T>>>::NEUTRALIZING)
+			if (!mem.try_reserve(top, oldTopAddr))
+				continue;
+
+		// try to detach the elems with one CAS
+		result = bclx::cas_sync(top, oldTopAddr, newTopAddr);
+
+		// unreserve top
+		mem.unreserve(oldTopAddr);
+
+		// check if the update is successful
+		if (result == oldTopAddr)
+		{
+			// tracing
+			#ifdef	TRACING
+				++succ_cs;
+				elem_cs += oldTopAddrs.size();
+			#endif
+
+			break;
+		}
+		else // if (result != oldTopAddr)
+		{
+			bk.delay_dbl();
+
+			// tracing
+			#ifdef	TRACING
+				fail_time += (MPI_Wtime() - start);
+				++fail_cs;
+			#endif
+		}
+	}
+
+	// deallocate global memory of the popped elems
+	for (uint64_t i = 0; i < oldTopAddrs.size(); ++i)
+		mem.retire(oldTopAddrs[i]);
+
+	// end a nonblocking operation
+	mem.op_end();
+
+	return oldTopAddrs.size();
+}
+
+template<typename T, template<typename> class M>
+void dds::ts::stack<T, M>::print()
 {
 	// synchronize
 	bclx::barrier_sync();
@@ -292,8 +486,8 @@ void dds::ts::stack<T>::print()
 	bclx::barrier_sync();
 }
 
-template<typename T>
-bool dds::ts::stack<T>::push_fill(const T &value)
+template<typename T, template<typename> class M>
+bool dds::ts::stack<T, M>::push_fill(const T &value)
 {
 	if (BCL::rank() == MASTER_UNIT)
 	{
@@ -312,11 +506,10 @@ bool dds::ts::stack<T>::push_fill(const T &value)
 		oldTopAddr = bclx::load(top);
 
 		// update new element (global memory)
-		#ifdef	MEM_DANG3
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
 			bclx::store({oldTopAddr, value}, newTopAddr);
-		#else
+		else
 			bclx::rput_sync({oldTopAddr, value}, newTopAddr);
-		#endif
 
 		// update top (global memory)
 		bclx::store(newTopAddr, top);
@@ -0,0 +1,396 @@
+#ifndef STACK_TS_POOL_H
+#define STACK_TS_POOL_H
+
+#include <vector>			// std::vector...
+#include <cstddef>			// offsetof...
+#include <algorithm>			// std::min...
+#include <bclx/core/util/clock.hpp>	// sync_clock::sync_clock...
+
+namespace dds
+{
+
+namespace tsp
+{
+
+/* Macros */
+using namespace bclx;
+
+/* Datatypes */
+struct timestamp
+{
+	uint64_t	start;
+	uint64_t	end;
+
+	bool operator<(const timestamp &) const;
+};
+
+template<typename T>
+struct item
+{
+	timestamp	ts;	// be the timestamp of the push
+	T		value;
+};
+
+template<typename T>
+struct slot
+{
+	uint64_t	tag;	// be the push sequence number (upper bits) and the state (lower bits)
+	item<T>		it;
+};
+
+template<typename T>
+class stack
+{
+public:
+	stack();			// collective
+	stack(const uint64_t &num);	// collective
+	~stack();			// collective
+	bool push(const T &value);	// non-collective
+	bool pop(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	const uint64_t		CAPACITY	= TOTAL_OPS;	// be the max # elems in the pool of a unit
+	const uint32_t		WINDOW		= 8;		// be # slots read from a pool per round
+	const uint32_t		COUNT_BITS	= 32;		// # bits of # slots in use in header
+	const uint64_t		FREE		= 0;		// state of a slot holding an elem
+	const uint64_t		CLAIMED		= 1;		// state of a slot being popped
+	const uint64_t		TAKEN		= 2;		// state of a popped slot
+	const uint64_t		STATE_MASK	= 3;
+	const uint64_t		OFFSET		= offsetof(slot<T>, it);
+
+	bclx::sync_clock	clk;		// be the synchronized local clock
+	gptr<uint64_t>		header;		// be # pushes (upper bits) and # slots in use (lower bits) of each pool
+	gptr<slot<T>>		slots;		// be the single-producer pool of each unit
+	uint64_t		pushes;		// be # pushes of the calling unit
+
+	void init(const uint64_t &num);
+	timestamp new_ts() const;
+	uint64_t tag_of(const uint64_t &seq, const uint64_t &state) const;
+	uint64_t header_of(const uint64_t &pushes, const uint64_t &count) const;
+	uint64_t count_of(const uint64_t &hdr) const;
+	bool try_rem(const timestamp &start_ts, bool &result, T &value);
+	bool remove(const uint64_t &rank, const uint64_t &index, const uint64_t &tag, T &value);
+};
+
+} /* namespace tsp */
+
+} /* namespace dds */
+
+bool dds::tsp::timestamp::operator<(const timestamp &ts) const
+{
+	return (end < ts.start);
+}
+
+template<typename T>
+dds::tsp::stack<T>::stack()
+{
+	init(0);
+}
+
+template<typename T>
+dds::tsp::stack<T>::stack(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T>
+dds::tsp::stack<T>::~stack()
+{
+	BCL::dealloc<slot<T>>(slots);
+	BCL::dealloc<uint64_t>(header);
+}
+
+template<typename T>
+bool dds::tsp::stack<T>::push(const T &value)
+{
+	uint64_t	count = count_of(bclx::aget_sync(header));	// local
+	gptr<uint64_t>	tag;
+
+	// take a timestamp without contacting any other unit
+	timestamp ts = new_ts();	// local
+
+	// drop the popped slots on top of the pool
+	tag.rank = BCL::rank();
+	while (count > 0)
+	{
+		tag.ptr = (slots + (count - 1)).ptr;
+		if ((bclx::aget_sync(tag) & STATE_MASK) != TAKEN)	// local
+			break;
+		--count;
+	}
+	if (count == CAPACITY)
+	{
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+
+		// out of memory: push back on the caller
+		return false;
+	}
+
+	// fill the slot before making it visible to the other units
+	gptr<slot<T>> addr = slots + count;
+	bclx::store(item<T>{ts, value}, gptr<item<T>>{addr.rank, addr.ptr + OFFSET});	// local
+	++pushes;
+	tag.ptr = addr.ptr;
+	bclx::aput_sync(tag_of(pushes, FREE), tag);			// local
+	bclx::aput_sync(header_of(pushes, count + 1), header);	// local
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+template<typename T>
+bool dds::tsp::stack<T>::pop(T &value)
+{
+	// elems stamped after this upper bound were pushed after the pop began
+	uint64_t	now = clk.upper();
+	timestamp	start_ts = {now, now};
+	bool		result = NON_EMPTY;
+
+	while (!try_rem(start_ts, result, value))
+	{
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+	}
+
+	if (result == NON_EMPTY)
+		return true;
+
+	printf("[%lu]ERROR: stack.pop\n", BCL::rank());
+	return false;
+}
+
+template<typename T>
+void dds::tsp::stack<T>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		gptr<uint64_t>		hdr_temp = header;
+		gptr<slot<T>>		slots_temp = slots;
+		std::vector<slot<T>>	pool;
+		uint64_t		count;
+
+		for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		{
+			hdr_temp.rank = slots_temp.rank = i;
+			count = count_of(bclx::aget_sync(hdr_temp));
+			pool.resize(count);
+			bclx::rget_sync(slots_temp, pool.data(), count);
+			for (uint64_t j = count; j > 0; --j)
+				if ((pool[j - 1].tag & STATE_MASK) == FREE)
+					printf("[%lu]value = %d, ts = {%lu, %lu}\n", i, pool[j - 1].it.value,
+							pool[j - 1].it.ts.start, pool[j - 1].it.ts.end);
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+void dds::tsp::stack<T>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	header = BCL::alloc<uint64_t>(1);
+	slots = BCL::alloc<slot<T>>(CAPACITY);
+	if (slots == nullptr)
+	{
+		printf("[%lu]ERROR: stack.stack\n", BCL::rank());
+		return;
+	}
+
+	slot<T>	*local = slots.local();
+	for (uint64_t i = 0; i < CAPACITY; ++i)
+		local[i].tag = tag_of(0, TAKEN);
+	pushes = 0;
+	bclx::store(header_of(0, 0), header);
+	if (BCL::rank() == MASTER_UNIT)
+		stack_name = "TSP";
+
+	// synchronize
+	bclx::barrier_sync();
+
+	// every unit fills its own pool with its share of the initial elems
+	for (uint64_t i = BCL::rank(); i < num; i += BCL::nprocs())
+		push(i);
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T>
+dds::tsp::timestamp dds::tsp::stack<T>::new_ts() const
+{
+	timestamp	ts;
+
+	clk.interval(TSS_INTERVAL, ts.start, ts.end);
+	return ts;
+}
+
+template<typename T>
+uint64_t dds::tsp::stack<T>::tag_of(const uint64_t &seq, const uint64_t &state) const
+{
+	return (seq << 2) | state;
+}
+
+template<typename T>
+uint64_t dds::tsp::stack<T>::header_of(const uint64_t &pushes, const uint64_t &count) const
+{
+	return (pushes << COUNT_BITS) | count;
+}
+
+template<typename T>
+uint64_t dds::tsp::stack<T>::count_of(const uint64_t &hdr) const
+{
+	return hdr & ((uint64_t(1) << COUNT_BITS) - 1);
+}
+
+template<typename T>
+bool dds::tsp::stack<T>::try_rem(const timestamp &start_ts, bool &result, T &value)
+{
+	std::vector<uint64_t>	hdr(BCL::nprocs()),
+				lo(BCL::nprocs()),
+				hi(BCL::nprocs()),
+				taken(BCL::nprocs());	// be the bottom of the run of popped slots on top of each pool
+	std::vector<slot<T>>	window(BCL::nprocs() * WINDOW);
+	std::vector<uint64_t>	open;		// contain the units whose youngest elem is not found yet
+	gptr<uint64_t>		hdr_temp = header;
+	gptr<slot<T>>		slots_temp = slots;
+	uint64_t		young_rank,
+				young_index,
+				young_tag;
+	timestamp		ts_max = {0, 0};
+	bool			found = false;
+
+	// gather the headers of all pools in one batch
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		hdr_temp.rank = i;
+		bclx::aget_async(hdr_temp, &hdr[i], 1);
+	}
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		bclx::flush(i);
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		hi[i] = taken[i] = count_of(hdr[i]);
+		if (hi[i] > 0)
+			open.push_back(i);
+	}
+
+	// gather the top slots of all pools in one batch, going deeper
+	// only into the pools whose top slots have all been popped
+	while (!open.empty())
+	{
+		for (uint64_t i : open)
+		{
+			lo[i] = hi[i] - std::min(hi[i], uint64_t(WINDOW));
+			slots_temp.rank = i;
+			bclx::aget_async(slots_temp + lo[i], &window[i * WINDOW], hi[i] - lo[i]);
+		}
+		for (uint64_t i : open)
+			bclx::flush(i);
+
+		std::vector<uint64_t> deeper;
+		for (uint64_t i : open)
+		{
+			uint64_t j = hi[i];
+			while (j > lo[i] && (window[i * WINDOW + j - 1 - lo[i]].tag & STATE_MASK) != FREE)
+				--j;
+
+			// extend the run of popped slots on top, which stops at the first
+			// claimed one: a claimed slot is still being read by its claimer
+			if (taken[i] == hi[i])
+				while (taken[i] > lo[i] && (window[i * WINDOW + taken[i] - 1 - lo[i]].tag & STATE_MASK) == TAKEN)
+					--taken[i];
+
+			if (j == lo[i] && j > 0)
+			{
+				hi[i] = lo[i];
+				deeper.push_back(i);
+				continue;
+			}
+
+			// hide a long run of popped slots (or a fully popped pool) from later pops;
+			// the CAS fails harmlessly if the owner has pushed in the meantime
+			if (taken[i] == 0 || count_of(hdr[i]) - taken[i] >= WINDOW)
+			{
+				hdr_temp.rank = i;
+				bclx::cas_sync(hdr_temp, hdr[i], header_of(hdr[i] >> COUNT_BITS, taken[i]));	// one RMA
+			}
+			if (j == 0)
+				continue;
+
+			// the youngest elem of a single-producer pool is its topmost free slot
+			slot<T> &s = window[i * WINDOW + j - 1 - lo[i]];
+
+			// elimination: the elem was pushed after the pop began
+			if (start_ts < s.it.ts)
+				return remove(i, j - 1, s.tag, value);
+
+			if (!found || ts_max < s.it.ts)
+			{
+				young_rank = i;
+				young_index = j - 1;
+				young_tag = s.tag;
+				ts_max = s.it.ts;
+				found = true;
+			}
+		}
+		open = std::move(deeper);
+	}
+
+	if (found)
+		return remove(young_rank, young_index, young_tag, value);
+
+	// emptiness check: no pool has received a push since its header was read
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		hdr_temp.rank = i;
+		if ((bclx::aget_sync(hdr_temp) >> COUNT_BITS) != (hdr[i] >> COUNT_BITS))	// one RMA
+			return false;
+	}
+	result = EMPTY;
+	return true;
+}
+
+template<typename T>
+bool dds::tsp::stack<T>::remove(const uint64_t &rank, const uint64_t &index, const uint64_t &tag, T &value)
+{
+	gptr<slot<T>>	addr = {rank, (slots + index).ptr};
+	gptr<uint64_t>	tag_addr = {rank, addr.ptr};
+	uint64_t	seq = tag >> 2;
+
+	// claim the slot, so that its owner does not reuse it while being read
+	if (bclx::cas_sync(tag_addr, tag, tag_of(seq, CLAIMED)) != tag)	// one RMA
+		return false;
+
+	value = bclx::rget_sync(gptr<item<T>>{rank, addr.ptr + OFFSET}).value;	// one RMA
+
+	// the owner reuses only popped slots, so the claim still holds; should it
+	// not, the value read may belong to a later push, so retry
+	if (bclx::cas_sync(tag_addr, tag_of(seq, CLAIMED), tag_of(seq, TAKEN)) != tag_of(seq, CLAIMED))	// one RMA
+		return false;
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	return true;
+}
+
+#endif /* STACK_TS_POOL_H */
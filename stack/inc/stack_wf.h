@@ -0,0 +1,395 @@
+#ifndef STACK_WF_H
+#define STACK_WF_H
+
+#include <vector>			// std::vector...
+#include "../../lock/inc/lock_fc.h"	// dds::fc::publication...
+
+namespace dds
+{
+
+namespace wfs
+{
+
+/* Macros */
+#ifdef		MEM_HP
+	using namespace hp;
+#elif defined 	MEM_HE
+	using namespace he;
+#elif defined	MEM_IBR
+	using namespace ibr;
+#elif defined	MEM_DANG3
+	using namespace dang3;
+#elif defined	MEM_NBR
+	using namespace nbr;
+#elif defined	MEM_BL3
+	using namespace bl3;
+#else	// No Memory Reclamation
+	using namespace nmr;
+#endif
+
+/* Datatypes */
+template<typename T>
+struct elem
+{
+        gptr<elem<T>>   next;
+        T               value;
+};
+
+enum op_type : uint32_t
+{
+	NONE,
+	PUSH,
+	POP
+};
+
+template<typename T>
+using request = fc::request<T>;
+
+template<typename T>
+using response = fc::response<T>;
+
+template<typename T>
+struct header
+{
+	uint64_t	version;	// be the version of the state
+	gptr<elem<T>>	top;		// be the top of the stack in the state
+};
+
+// a state of the stack is a record holding its top and the response to the last
+// request of every unit. Every op announces its request, then combines all the
+// announced requests into a new record and installs it with one CAS on the state
+// word. An op whose own round fails twice has been applied by a unit whose CAS
+// succeeded, as that unit read the announcements after this op was announced.
+// The installing unit then puts the response of every op it served into the
+// response slot of the unit of that op, so no op takes more than two combining
+// rounds, however hot the state word is, plus a wait on its own slot for a put
+// its installer issues right after its CAS
+template<typename T, template<typename> class M = memory>
+class stack
+{
+public:
+	M<elem<T>>		mem;	// manage global memory
+
+	stack();			// collective
+	stack(const uint64_t &num);	// collective
+	~stack();			// collective
+	bool push(const T &value);	// non-collective
+	bool pop(T &value);		// non-collective
+	void print();			// collective
+
+private:
+	const gptr<elem<T>> 	NULL_PTR = nullptr; 	// be a null constant
+
+	gptr<uint64_t>		state;	// be the version (upper bits) and the record (lower bits) of the current state (hosted by MASTER_UNIT)
+	fc::publication<T>	pub;	// be the announce array (hosted by MASTER_UNIT)
+	gptr<header<T>>		hdrs;	// be the headers of the two state records of each unit
+	gptr<response<T>>	resps;	// be the responses of the two state records of each unit
+	gptr<response<T>>	done;	// be the response slot of each unit
+	uint64_t		seq;	// be the sequence number of the last request of the calling unit
+	uint32_t		spare;	// be the record of the calling unit that is not installed
+
+	void init(const uint64_t &num);
+	uint64_t state_of(const uint64_t &version, const uint64_t &rank, const uint64_t &rec) const;
+	bool valid(const gptr<elem<T>> &addr) const;
+	bool apply(const uint32_t &op, T &value);
+	bool combine();
+	bool push_fill(const T &value);
+};
+
+} /* namespace wfs */
+
+} /* namespace dds */
+
+template<typename T, template<typename> class M>
+dds::wfs::stack<T, M>::stack()
+{
+	init(0);
+}
+
+template<typename T, template<typename> class M>
+dds::wfs::stack<T, M>::stack(const uint64_t &num)
+{
+	init(num);
+}
+
+template<typename T, template<typename> class M>
+dds::wfs::stack<T, M>::~stack()
+{
+	state.rank = BCL::rank();
+	BCL::dealloc<response<T>>(done);
+	BCL::dealloc<response<T>>(resps);
+	BCL::dealloc<header<T>>(hdrs);
+	BCL::dealloc<uint64_t>(state);
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::push(const T &value)
+{
+	T	temp = value;
+
+	return apply(PUSH, temp);
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::pop(T &value)
+{
+	if (apply(POP, value))
+		return true;
+
+	printf("[%lu]ERROR: stack.pop\n", BCL::rank());
+	return false;
+}
+
+template<typename T, template<typename> class M>
+void dds::wfs::stack<T, M>::print()
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		uint64_t	st = bclx::load(state);
+		header<T>	hdr = bclx::rget_sync(gptr<header<T>>{(st & 0xffffffff) >> 1, (hdrs + (st & 1)).ptr});
+		gptr<elem<T>>	topAddr;
+		elem<T>		topVal;
+
+		for (topAddr = hdr.top; topAddr != nullptr; topAddr = topVal.next)
+		{
+			topVal = bclx::rget_sync(topAddr);
+			printf("value = %d\n", topVal.value);
+			topVal.next.print();
+		}
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+void dds::wfs::stack<T, M>::init(const uint64_t &num)
+{
+	// synchronize
+	bclx::barrier_sync();
+
+	state = BCL::alloc<uint64_t>(1);
+	hdrs = BCL::alloc<header<T>>(2);
+	resps = BCL::alloc<response<T>>(2 * BCL::nprocs());
+	done = BCL::alloc<response<T>>(1);
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+	{
+		bclx::store(response<T>{0, false, T()}, resps + i);
+		bclx::store(response<T>{0, false, T()}, resps + (BCL::nprocs() + i));
+	}
+	bclx::store(header<T>{0, NULL_PTR}, hdrs);
+	bclx::store(header<T>{0, NULL_PTR}, hdrs + 1);
+	bclx::store(response<T>{0, false, T()}, done);
+	seq = 0;
+
+	// the first record of MASTER_UNIT is the initial state
+	if (BCL::rank() == MASTER_UNIT)
+	{
+		bclx::store(state_of(0, MASTER_UNIT, 0), state);
+		spare = 1;
+		stack_name = "WFS";
+
+		for (uint64_t i = 0; i < num; ++i)
+			push_fill(i);
+	}
+	else
+	{
+		spare = 0;
+		state.rank = MASTER_UNIT;
+	}
+
+	// synchronize
+	bclx::barrier_sync();
+}
+
+template<typename T, template<typename> class M>
+uint64_t dds::wfs::stack<T, M>::state_of(const uint64_t &version, const uint64_t &rank, const uint64_t &rec) const
+{
+	return (version << 32) | (rank << 1) | rec;
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::valid(const gptr<elem<T>> &addr) const
+{
+	return addr.rank < BCL::nprocs() && addr.ptr + sizeof(elem<T>) <= BCL::shared_segment_size;
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::apply(const uint32_t &op, T &value)
+{
+	response<T>	resp;
+
+	// announce the request
+	seq = pub.publish(op, value);	// two RMAs
+
+	// the request is applied by the end of the second round
+	for (uint32_t round = 0; round < 2; ++round)
+	{
+		resp = bclx::rget_sync(done);	// local
+		if (resp.seq == seq || combine())
+			break;
+
+		// tracing
+		#ifdef	TRACING
+			++fail_cs;
+		#endif
+	}
+
+	// wait for its installer to put the response
+	while (resp.seq != seq)
+		resp = bclx::rget_sync(done);	// local
+
+	// tracing
+	#ifdef	TRACING
+		++succ_cs;
+	#endif
+
+	if (op == POP)
+		value = resp.value;
+	return resp.status;
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::combine()
+{
+	std::vector<request<T>>		anns;
+	std::vector<response<T>>	cells(BCL::nprocs());
+	std::vector<uint64_t>		pushers,	// contain the units whose pushes are not matched yet
+					served;		// contain the units whose requests this round serves
+	std::vector<gptr<elem<T>>>	popped,
+					pushed;
+	header<T>			hdr;
+	gptr<elem<T>>			newTopAddr;
+	elem<T>				topVal;
+	uint64_t			st,
+					rank;
+
+	// get the current state record in one batch
+	st = bclx::aget_sync(state);	// one RMA
+	rank = (st & 0xffffffff) >> 1;
+	bclx::aget_async(gptr<header<T>>{rank, (hdrs + (st & 1)).ptr}, &hdr, 1);
+	bclx::aget_async(gptr<response<T>>{rank, (resps + (st & 1) * BCL::nprocs()).ptr}, cells.data(), BCL::nprocs());
+	bclx::flush(rank);
+
+	// the record may have been rewritten by its owner while being read
+	if (bclx::aget_sync(state) != st)	// one RMA
+		return false;
+
+	// the request has been applied by another unit, which puts its response
+	if (cells[BCL::rank()].seq == seq)
+		return true;
+
+	// get the announced requests (from global memory to local memory)
+	pub.requests(anns);	// one RMA
+
+	// apply the pending pushes before the pending pops, so that a pop takes the
+	// value of a pending push without the value ever entering the stack
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (anns[i].seq != cells[i].seq && anns[i].op == PUSH)
+		{
+			cells[i] = {anns[i].seq, true, T()};
+			pushers.push_back(i);
+			served.push_back(i);
+		}
+	newTopAddr = hdr.top;
+	for (uint64_t i = 0; i < BCL::nprocs(); ++i)
+		if (anns[i].seq != cells[i].seq && anns[i].op == POP)
+		{
+			served.push_back(i);
+			if (!pushers.empty())
+			{
+				cells[i] = {anns[i].seq, true, anns[pushers.back()].value};
+				pushers.pop_back();
+			}
+			else if (newTopAddr == nullptr)
+				cells[i] = {anns[i].seq, EMPTY, T()};
+			else
+			{
+				// the elems of a stale record may have been freed and reused:
+				// whatever is read is only used if the CAS below succeeds
+				if (!valid(newTopAddr))
+					return false;
+				topVal = bclx::rget_sync(newTopAddr);	// one RMA
+				cells[i] = {anns[i].seq, true, topVal.value};
+				popped.push_back(newTopAddr);
+				newTopAddr = topVal.next;
+			}
+		}
+
+	// link the values of the unmatched pushes onto the new top
+	for (uint64_t i : pushers)
+	{
+		gptr<elem<T>> addr = mem.malloc();
+		if (addr == nullptr)
+		{
+			// out of memory: push back on the caller
+			cells[i].status = false;
+			continue;
+		}
+		if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+			bclx::store({newTopAddr, anns[i].value}, addr);
+		else
+			bclx::rput_sync({newTopAddr, anns[i].value}, addr);
+		pushed.push_back(addr);
+		newTopAddr = addr;
+	}
+
+	// write the new state into the spare record and try to install it
+	bclx::store(header<T>{(st >> 32) + 1, newTopAddr}, hdrs + spare);				// local
+	bclx::store(cells.data(), resps + spare * BCL::nprocs(), BCL::nprocs());		// local
+	if (bclx::cas_sync(state, st, state_of((st >> 32) + 1, BCL::rank(), spare)) == st)	// one RMA
+	{
+		spare ^= 1;
+
+		// no state from now on reaches the popped elems, and a unit still reading
+		// them holds a stale record, so they can be freed at once
+		for (uint64_t i = 0; i < popped.size(); ++i)
+			mem.free(popped[i]);
+
+		// put the responses of the served requests in one batch
+		for (uint64_t i : served)
+			bclx::rput_async(cells[i], gptr<response<T>>{i, done.ptr});
+		for (uint64_t i : served)
+			bclx::flush(i);
+		return true;
+	}
+
+	// the elems of the new state have never been visible
+	for (uint64_t i = 0; i < pushed.size(); ++i)
+		mem.free(pushed[i]);
+	return false;
+}
+
+template<typename T, template<typename> class M>
+bool dds::wfs::stack<T, M>::push_fill(const T &value)
+{
+	gptr<elem<T>>		oldTopAddr,
+				newTopAddr;
+
+	// allocate global memory to the new elem
+	newTopAddr = mem.malloc();
+	if (newTopAddr == nullptr)
+	{
+		printf("[%lu]ERROR: stack.push_fill\n", BCL::rank());
+		return false;
+	}
+
+	// get top (from global memory to local memory)
+	oldTopAddr = bclx::load(hdrs).top;
+
+	// update new element (global memory)
+	if constexpr (mem_traits<M<elem<T>>>::LOCAL_ALLOC)
+		bclx::store({oldTopAddr, value}, newTopAddr);
+	else
+		bclx::rput_sync({oldTopAddr, value}, newTopAddr);
+
+	// update top (global memory)
+	bclx::store(header<T>{0, newTopAddr}, hdrs);
+
+	return true;
+}
+
+#endif /* STACK_WF_H */